@@ -0,0 +1,172 @@
+#pragma once
+#include <cstddef>
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Heap activity counted by the allocation tracker.
+     */
+    struct AllocationCounts {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t bytes = 0;
+    };
+
+    namespace detail {
+        /**
+         * @brief Per-thread totals, updated by the replacement operator new/delete.
+         */
+        inline thread_local AllocationCounts thread_allocations;
+
+        /**
+         * @brief Set when a translation unit installed the replacement operators.
+         */
+        inline bool allocation_tracker_installed = false;
+    }
+
+    /**
+     * @brief Whether allocations are being counted in this binary.
+     * @return True if the replacement operators are linked in (see below).
+     */
+    inline bool allocation_tracking_enabled() {
+        return detail::allocation_tracker_installed;
+    }
+
+    /**
+     * @brief Counts heap allocations made by the current thread during its lifetime.
+     *
+     * Opt-in: exactly one translation unit of the binary must define
+     * MYCONTAINER_ALLOCATION_TRACKER_IMPLEMENTATION before including this
+     * header, which replaces the global operator new/delete. Without it the
+     * counts stay zero. Allocations made by other threads (e.g. pool workers)
+     * are not attributed to the scope.
+     */
+    class ScopedAllocationCounter {
+    private:
+        AllocationCounts start = detail::thread_allocations;
+
+    public:
+        /**
+         * @brief Returns the activity since construction.
+         * @return Allocations, deallocations and bytes requested.
+         */
+        AllocationCounts counts() const {
+            const AllocationCounts& now = detail::thread_allocations;
+            return {now.allocations - start.allocations, now.deallocations - start.deallocations,
+                    now.bytes - start.bytes};
+        }
+
+        /**
+         * @brief Returns the number of allocations since construction.
+         * @return The allocation count.
+         */
+        size_t allocations() const {
+            return detail::thread_allocations.allocations - start.allocations;
+        }
+
+        /**
+         * @brief Returns the bytes requested since construction.
+         * @return The byte count.
+         */
+        size_t bytes() const {
+            return detail::thread_allocations.bytes - start.bytes;
+        }
+
+        /**
+         * @brief Starts counting again from zero.
+         */
+        void reset() {
+            start = detail::thread_allocations;
+        }
+    };
+
+}
+
+#ifdef MYCONTAINER_ALLOCATION_TRACKER_IMPLEMENTATION
+#include <cstdlib>
+#include <new>
+
+namespace MyContainerNamespace {
+    namespace detail {
+        inline void* tracked_allocate(std::size_t size, std::size_t alignment) {
+            if (size == 0) {
+                size = 1;
+            }
+            void* p = nullptr;
+            if (alignment <= alignof(std::max_align_t)) {
+                p = std::malloc(size);
+            } else if (posix_memalign(&p, alignment, size) != 0) {
+                p = nullptr;
+            }
+            if (p != nullptr) {
+                ++thread_allocations.allocations;
+                thread_allocations.bytes += size;
+            }
+            return p;
+        }
+
+        // Kept out of line: once inlined into operator delete, GCC pairs the
+        // free() with the caller's operator new and warns (-Wmismatched-new-delete).
+#if defined(__GNUC__)
+        __attribute__((noinline))
+#endif
+        inline void tracked_free(void* p) {
+            if (p != nullptr) {
+                ++thread_allocations.deallocations;
+                std::free(p);
+            }
+        }
+
+        static const bool allocation_tracker_registered = (allocation_tracker_installed = true);
+    }
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = MyContainerNamespace::detail::tracked_allocate(size, 0)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return MyContainerNamespace::detail::tracked_allocate(size, 0);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return MyContainerNamespace::detail::tracked_allocate(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = MyContainerNamespace::detail::tracked_allocate(size, static_cast<std::size_t>(alignment))) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+void operator delete(void* p) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete[](void* p) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    MyContainerNamespace::detail::tracked_free(p);
+}
+#endif
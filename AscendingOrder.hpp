@@ -1,95 +1,40 @@
 #pragma once
 #include <vector>
 #include <algorithm>
-#include <stdexcept>
+#include "OrderedIterator.hpp"
+#include "Instrumentation.hpp"
 
 namespace MyContainerNamespace {
 
-    template<typename T>
-    class MyContainer;
-
-    template<typename T>
-    class AscendingOrder {
-    private:
-        const MyContainer<T>& container; 
-        std::vector<size_t> indices; 
-        size_t current_index; 
-
-    public:
-        /**
-         * @brief Constructor for the AscendingOrder.
-         * @param cont Reference to the container.
-         * @param pos The starting position (default is 0).
-         */
-       explicit AscendingOrder(const MyContainer<T>& cont, size_t pos = 0)
-            : container(cont), current_index(pos) {
-            if (container.size() > 0) {
-                indices.resize(container.size());
-                for (size_t i = 0; i < container.size(); ++i) {
-                    indices[i] = i;
-                }
-                std::sort(indices.begin(), indices.end(),
-                    [this](size_t a, size_t b) {
-                        return container.getData()[a] < container.getData()[b];
-                    });
-            }
-}
-
-        /**
-         * @brief Access current element.
-         * @return Reference to the current element.
-         * @throw std::out_of_range If out of bounds
-         */
-        const T& operator*() const {
-            if (current_index >= indices.size()) {
-                throw std::out_of_range("Iterator out of bounds");
-            }
-            return container.getData()[indices[current_index]];
-        }
-
-        /**
-         * @brief Advance to next position.
-         * @return Reference after increment.
-         * @throw std::out_of_range If incrementing past end
-         */
-        AscendingOrder& operator++() {
-            if (current_index >= indices.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
-            }
-            ++current_index;
-            return *this;
-        }
+    /**
+     * @brief Mapping policy that visits elements from smallest to largest.
+     */
+    struct AscendingMapping {
+        static constexpr bool trusted = true;
+        static constexpr const char* trace_name = "AscendingOrder index build";
 
         /**
-         * @brief Advance to next position.
-         * @return Copy before increment.
-         * @throw std::out_of_range If incrementing past end
+         * @brief Builds the ascending permutation of the data.
+         * @param data The container's elements.
+         * @param indices Output: data indices sorted by ascending value.
          */
-        AscendingOrder operator++(int) {
-            if (current_index >= indices.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
+        template<typename T>
+        void build(const std::vector<T>& data, std::vector<size_t>& indices) const {
+            indices.resize(data.size());
+            for (size_t i = 0; i < data.size(); ++i) {
+                indices[i] = i;
             }
-            AscendingOrder temp = *this;
-            ++current_index;
-            return temp;
+            detail::sort_indices(indices,
+                [&data](size_t a, size_t b) {
+                    return data[a] < data[b];
+                });
         }
+    };
 
-        /**
-         * @brief Compare equality.
-         * @param other Another iterator.
-         * @return True if same position and container.
-         */
-        bool operator==(const AscendingOrder& other) const {
-            return current_index == other.current_index && &container == &other.container;
-        }
+    /**
+     * @brief Iterator over the container in ascending order.
+     */
+    template<typename T>
+    using AscendingOrder = OrderedIterator<T, AscendingMapping>;
 
-        /**
-         * @brief Compare inequality.
-         * @param other Another iterator.
-         * @return True if different position or container.
-         */
-        bool operator!=(const AscendingOrder& other) const {
-            return !(*this == other);
-        }
-    };
-}
\ No newline at end of file
+}
@@ -0,0 +1,145 @@
+#pragma once
+// Hardware performance counters for the benchmarks, read with Linux
+// perf_event_open. Counters that cannot be opened (non-Linux builds,
+// perf_event_paranoid, containers without a PMU, seccomp) are reported as
+// unavailable instead of failing the benchmark.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Counter values for one measured region; a counter that could not be
+ * read has its flag cleared.
+ */
+struct PerfSample {
+    enum Counter { Cycles, Instructions, CacheMisses, BranchMisses, Count };
+
+    uint64_t value[Count] = {};
+    bool valid[Count] = {};
+
+    /**
+     * @brief Instructions per cycle.
+     * @return The IPC, or a negative value if either counter is missing.
+     */
+    double ipc() const {
+        if (!valid[Cycles] || !valid[Instructions] || value[Cycles] == 0) {
+            return -1.0;
+        }
+        return static_cast<double>(value[Instructions]) / static_cast<double>(value[Cycles]);
+    }
+};
+
+/**
+ * @brief Per-thread cycles, instructions, cache-miss and branch-miss counters
+ * (user space only) around a region: start(), run the region, stop().
+ */
+class PerfCounters {
+private:
+    int fd[PerfSample::Count];
+
+#ifdef __linux__
+    static int open_counter(uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+#ifdef __linux__
+        const uint64_t configs[PerfSample::Count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                     PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            fd[i] = open_counter(configs[i]);
+        }
+#else
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            fd[i] = -1;
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            if (fd[i] >= 0) {
+                close(fd[i]);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Whether at least one counter could be opened.
+     * @return True if start()/stop() will report anything.
+     */
+    bool available() const {
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            if (fd[i] >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Zeroes and enables the counters.
+     */
+    void start() {
+#ifdef __linux__
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            if (fd[i] >= 0) {
+                ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Disables the counters and reads them.
+     *
+     * When the kernel had to multiplex counters, values are scaled by
+     * enabled/running time. A counter that never ran is reported missing.
+     * @return The counts since start().
+     */
+    PerfSample stop() {
+        PerfSample sample;
+#ifdef __linux__
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            if (fd[i] >= 0) {
+                ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        for (int i = 0; i < PerfSample::Count; ++i) {
+            uint64_t data[3];
+            if (fd[i] < 0 || read(fd[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+                continue;
+            }
+            sample.value[i] = data[2] == data[1]
+                ? data[0]
+                : static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                        static_cast<double>(data[2]));
+            sample.valid[i] = true;
+        }
+#endif
+        return sample;
+    }
+};
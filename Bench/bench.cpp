@@ -0,0 +1,349 @@
+// Benchmark suite for MyContainer: add, remove, operator[], operator<< and
+// begin/end/full traversal of every order, for int, double, std::string and
+// a 64-byte record, at sizes from 1e2 up to --max-size. Results are written
+// as JSON (one object per measurement) to stdout or to --out=FILE, with the
+// heap allocations made inside the timed region and, where the kernel allows
+// perf_event_open, the cycles, instructions, cache misses and branch misses
+// of the calling thread (IPC and misses per operation are derived from them;
+// unavailable counters are written as null).
+//
+// Usage: ./bench_suite [--min-size=N] [--max-size=N] [--types=int,double,string,record64]
+//                      [--out=FILE]
+// Sizes accept scientific notation (e.g. --max-size=1e8); they step by 10x.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#define MYCONTAINER_ALLOCATION_TRACKER_IMPLEMENTATION
+#include "../AllocationTracker.hpp"
+#include "../MyContainer.hpp"
+#include "PerfCounters.hpp"
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 64-byte element ordered by its key.
+ */
+struct Record64 {
+    uint64_t key = 0;
+    uint64_t payload[7] = {};
+
+    bool operator<(const Record64& other) const { return key < other.key; }
+    bool operator>(const Record64& other) const { return key > other.key; }
+    bool operator==(const Record64& other) const { return key == other.key; }
+    friend std::ostream& operator<<(std::ostream& os, const Record64& r) { return os << r.key; }
+};
+static_assert(sizeof(Record64) == 64, "Record64 must be 64 bytes");
+
+template<typename T>
+static T make_value(uint64_t i);
+
+template<>
+int make_value<int>(uint64_t i) { return static_cast<int>(detail::mix64(i) >> 33); }
+
+template<>
+double make_value<double>(uint64_t i) { return static_cast<double>(detail::mix64(i) >> 11) * 0x1.0p-53; }
+
+template<>
+std::string make_value<std::string>(uint64_t i) { return "key-" + std::to_string(detail::mix64(i)); }
+
+template<>
+Record64 make_value<Record64>(uint64_t i) {
+    Record64 r;
+    r.key = detail::mix64(i);
+    for (uint64_t& word : r.payload) {
+        word = i;
+    }
+    return r;
+}
+
+static uint64_t sink_value = 0;
+
+static void sink(int v) { sink_value += static_cast<uint64_t>(v); }
+static void sink(double v) { sink_value += static_cast<uint64_t>(v * 1e6); }
+static void sink(const std::string& v) { sink_value += v.size(); }
+static void sink(const Record64& v) { sink_value += v.key; }
+
+/**
+ * @brief streambuf that only counts bytes, so operator<< is timed without I/O.
+ */
+class CountingBuffer : public std::streambuf {
+public:
+    size_t bytes = 0;
+
+protected:
+    int_type overflow(int_type ch) override {
+        ++bytes;
+        return ch;
+    }
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        bytes += static_cast<size_t>(count);
+        return count;
+    }
+};
+
+/**
+ * @brief One timed region: best wall time over the repetitions.
+ */
+struct Measurement {
+    double best_ns = 0.0;
+    size_t repetitions = 0;
+    size_t operations = 0;
+    AllocationCounts heap;
+    PerfSample counters;
+};
+
+static PerfCounters& perf_counters() {
+    static PerfCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Times body (after an untimed setup per repetition) and keeps the fastest run.
+ * Heap activity and hardware counters are those of the fastest run.
+ * @param repetitions Number of timed runs.
+ * @param operations Operations per run, for per-operation figures.
+ * @param setup Untimed preparation, run before every repetition.
+ * @param body The timed region.
+ */
+template<typename Setup, typename Body>
+static Measurement measure(size_t repetitions, size_t operations, Setup setup, Body body) {
+    Measurement m;
+    m.repetitions = repetitions;
+    m.operations = operations;
+    m.best_ns = 1e300;
+    for (size_t r = 0; r < repetitions; ++r) {
+        setup();
+        ScopedAllocationCounter allocations;
+        perf_counters().start();
+        auto start = Clock::now();
+        body();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        PerfSample counters = perf_counters().stop();
+        if (ns < m.best_ns) {
+            m.best_ns = ns;
+            m.heap = allocations.counts();
+            m.counters = counters;
+        }
+    }
+    return m;
+}
+
+/**
+ * @brief Streams results as a JSON document.
+ */
+class JsonReport {
+private:
+    std::ostream& out;
+    bool first = true;
+
+    void counter(const char* name, const Measurement& m, PerfSample::Counter which, bool per_op) {
+        out << ", \"" << name << "\": ";
+        if (!m.counters.valid[which]) {
+            out << "null";
+        } else if (per_op) {
+            out << (m.operations ? static_cast<double>(m.counters.value[which]) / static_cast<double>(m.operations) : 0.0);
+        } else {
+            out << m.counters.value[which];
+        }
+    }
+
+public:
+    JsonReport(std::ostream& os, size_t min_size, size_t max_size) : out(os) {
+        out << "{\n  \"suite\": \"MyContainer\",\n"
+            << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+            << "  \"perf_counters\": " << (perf_counters().available() ? "true" : "false") << ",\n"
+            << "  \"min_size\": " << min_size << ",\n  \"max_size\": " << max_size << ",\n"
+            << "  \"results\": [";
+    }
+
+    void add(const std::string& type, size_t size, const std::string& op, const std::string& order,
+             const Measurement& m) {
+        out << (first ? "\n" : ",\n") << "    {\"type\": \"" << type << "\", \"size\": " << size
+            << ", \"op\": \"" << op << "\", \"order\": \"" << order << "\""
+            << ", \"ns\": " << m.best_ns << ", \"operations\": " << m.operations
+            << ", \"ns_per_op\": " << (m.operations ? m.best_ns / static_cast<double>(m.operations) : 0.0)
+            << ", \"repetitions\": " << m.repetitions
+            << ", \"allocations\": " << m.heap.allocations << ", \"allocated_bytes\": " << m.heap.bytes;
+        counter("cycles", m, PerfSample::Cycles, false);
+        counter("instructions", m, PerfSample::Instructions, false);
+        counter("cache_misses", m, PerfSample::CacheMisses, false);
+        counter("branch_misses", m, PerfSample::BranchMisses, false);
+        out << ", \"ipc\": ";
+        if (m.counters.ipc() < 0) {
+            out << "null";
+        } else {
+            out << m.counters.ipc();
+        }
+        counter("cache_misses_per_op", m, PerfSample::CacheMisses, true);
+        counter("branch_misses_per_op", m, PerfSample::BranchMisses, true);
+        out << "}";
+        out.flush();
+        first = false;
+    }
+
+    ~JsonReport() {
+        out << "\n  ]\n}\n";
+    }
+};
+
+/**
+ * @brief begin/end/traversal measurements for one order.
+ */
+template<typename T, typename Begin, typename End>
+static void bench_order(JsonReport& report, const std::string& type, const std::vector<T>& values,
+                        const std::string& order, size_t repetitions, Begin begin, End end) {
+    size_t n = values.size();
+    const size_t inner = 1000;
+    MyContainer<T> c;
+
+    // A fresh container each time, so permutation orders pay for their build.
+    report.add(type, n, "begin_cold", order, measure(repetitions, 1,
+        [&]() { c = MyContainer<T>(values); },
+        [&]() { auto it = begin(c); sink(*it); }));
+    report.add(type, n, "begin_warm", order, measure(repetitions, inner,
+        [&]() {},
+        [&]() { for (size_t i = 0; i < inner; ++i) { auto it = begin(c); sink(*it); } }));
+    report.add(type, n, "end", order, measure(repetitions, inner,
+        [&]() {},
+        [&]() { for (size_t i = 0; i < inner; ++i) { auto it = end(c); sink_value += it.position(); } }));
+    report.add(type, n, "traverse", order, measure(repetitions, n,
+        [&]() {},
+        [&]() { for (auto it = begin(c), last = end(c); it != last; ++it) sink(*it); }));
+}
+
+template<typename T>
+static void bench_type(JsonReport& report, const std::string& type, size_t n) {
+    std::vector<T> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(make_value<T>(i));
+    }
+    size_t repetitions = n <= 100000 ? 5 : (n <= 1000000 ? 3 : 1);
+    MyContainer<T> c;
+
+    report.add(type, n, "add", "", measure(repetitions, n,
+        [&]() { c = MyContainer<T>(); },
+        [&]() { for (const T& v : values) c.add(v); }));
+
+    // remove() scans the whole container, so fewer removals at larger sizes.
+    size_t removals = std::clamp<size_t>(10000000 / n, 1, 64);
+    removals = std::min(removals, n);
+    report.add(type, n, "remove", "", measure(repetitions, removals,
+        [&]() { c = MyContainer<T>(values); },
+        [&]() {
+            for (size_t i = 0; i < removals; ++i) {
+                try {
+                    c.remove(values[(i * 7919) % n]);
+                } catch (const std::invalid_argument&) {
+                    // A duplicate value already removed with an earlier one.
+                }
+            }
+        }));
+
+    c = MyContainer<T>(values);
+    const MyContainer<T>& view = c;
+    std::vector<size_t> probes(std::min<size_t>(n, 1000000));
+    for (size_t i = 0; i < probes.size(); ++i) {
+        probes[i] = detail::mix64(i) % n;
+    }
+    report.add(type, n, "operator[]", "", measure(repetitions, probes.size(),
+        [&]() {},
+        [&]() { for (size_t i : probes) sink(view[i]); }));
+    // Non-const access hands out a mutable reference; it must stay as cheap as a read.
+    report.add(type, n, "operator[] mutable", "", measure(repetitions, probes.size(),
+        [&]() {},
+        [&]() { for (size_t i : probes) sink(c[i]); }));
+
+    report.add(type, n, "operator<<", "", measure(repetitions, n,
+        [&]() {},
+        [&]() {
+            CountingBuffer buffer;
+            std::ostream os(&buffer);
+            os << view;
+            sink_value += buffer.bytes;
+        }));
+
+    bench_order(report, type, values, "insertion", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_order(); }, [](const MyContainer<T>& x) { return x.end_order(); });
+    bench_order(report, type, values, "reverse", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_reverse_order(); }, [](const MyContainer<T>& x) { return x.end_reverse_order(); });
+    bench_order(report, type, values, "ascending", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_ascending_order(); }, [](const MyContainer<T>& x) { return x.end_ascending_order(); });
+    bench_order(report, type, values, "descending", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_descending_order(); }, [](const MyContainer<T>& x) { return x.end_descending_order(); });
+    bench_order(report, type, values, "side_cross", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_side_cross_order(); }, [](const MyContainer<T>& x) { return x.end_side_cross_order(); });
+    bench_order(report, type, values, "middle_out", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_middle_out_order(); }, [](const MyContainer<T>& x) { return x.end_middle_out_order(); });
+    bench_order(report, type, values, "random", repetitions,
+        [](const MyContainer<T>& x) { return x.begin_random_order(); }, [](const MyContainer<T>& x) { return x.end_random_order(); });
+}
+
+static size_t parse_size(const std::string& text) {
+    return static_cast<size_t>(std::strtod(text.c_str(), nullptr));
+}
+
+int main(int argc, char** argv) {
+    size_t min_size = 100;
+    size_t max_size = 1000000;
+    std::string types = "int,double,string,record64";
+    std::string out_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--min-size=", 0) == 0) {
+            min_size = std::max<size_t>(1, parse_size(arg.substr(11)));
+        } else if (arg.rfind("--max-size=", 0) == 0) {
+            max_size = parse_size(arg.substr(11));
+        } else if (arg.rfind("--types=", 0) == 0) {
+            types = arg.substr(8);
+        } else if (arg.rfind("--out=", 0) == 0) {
+            out_path = arg.substr(6);
+        } else {
+            std::cerr << "unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!out_path.empty()) {
+        file.open(out_path);
+        if (!file) {
+            std::cerr << "cannot open " << out_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = out_path.empty() ? std::cout : file;
+    {
+        JsonReport report(out, min_size, max_size);
+        std::stringstream list(types);
+        std::string type;
+        while (std::getline(list, type, ',')) {
+            for (size_t n = min_size; n <= max_size; n *= 10) {
+                if (type == "int") {
+                    bench_type<int>(report, type, n);
+                } else if (type == "double") {
+                    bench_type<double>(report, type, n);
+                } else if (type == "string") {
+                    bench_type<std::string>(report, type, n);
+                } else if (type == "record64") {
+                    bench_type<Record64>(report, type, n);
+                } else {
+                    std::cerr << "unknown type: " << type << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cerr << "checksum " << sink_value << std::endl;
+    return 0;
+}
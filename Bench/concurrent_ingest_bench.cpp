@@ -0,0 +1,60 @@
+// Compares ingestion throughput of a mutex-guarded MyContainer against
+// ConcurrentMyContainer (sharded, lock-free slot reservation) for 1 to 64
+// producer threads, including the final freeze().
+//
+// Usage: ./concurrent_ingest_bench [total_elements]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../ConcurrentMyContainer.hpp"
+
+using namespace MyContainerNamespace;
+
+template<typename AddFn>
+static double run_producers(size_t producers, size_t total, AddFn add) {
+    std::vector<std::thread> threads;
+    size_t per_producer = total / producers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&add, p, per_producer]() {
+            for (size_t i = 0; i < per_producer; ++i) {
+                add(static_cast<int>(p * per_producer + i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    for (size_t producers = 1; producers <= 64; producers *= 2) {
+        MyContainer<int> locked;
+        std::mutex lock;
+        double mutex_seconds = run_producers(producers, total, [&](int value) {
+            std::lock_guard<std::mutex> guard(lock);
+            locked.add(value);
+        });
+
+        ConcurrentMyContainer<int> sharded;
+        double sharded_seconds = run_producers(producers, total, [&](int value) {
+            sharded.add(value);
+        });
+        auto freeze_start = std::chrono::steady_clock::now();
+        MyContainer<int> sealed = sharded.freeze();
+        double freeze_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - freeze_start).count();
+
+        std::cout << "producers=" << producers
+                  << " mutex=" << (total / mutex_seconds / 1e6) << " Madds/s"
+                  << " sharded=" << (total / sharded_seconds / 1e6) << " Madds/s"
+                  << " freeze=" << freeze_seconds * 1e3 << " ms"
+                  << " (" << sealed.size() << " elements)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Compares MyContainer's operator<< (std::to_chars into a local buffer) with
+// the previous element-by-element stream insertion, for int, long long and
+// double containers, writing to a stringstream and to /dev/null. Checks that
+// both produce the same bytes and reports time and output bandwidth.
+//
+// Usage: ./format_bench [elements]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../MyContainer.hpp"
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The previous operator<<: every element and separator goes through the stream.
+ */
+template<typename T>
+static void print_each(std::ostream& os, const MyContainer<T>& container) {
+    const std::vector<T>& data = container.getData();
+    os << "[";
+    for (size_t i = 0; i < data.size(); ++i) {
+        os << data[i];
+        if (i < data.size() - 1) {
+            os << ", ";
+        }
+    }
+    os << "]";
+}
+
+template<typename Print>
+static double best_seconds(Print print) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        auto start = Clock::now();
+        print();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+template<typename T>
+static void bench_type(const char* name, size_t n, T (*make)(uint64_t)) {
+    std::vector<T> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(make(i));
+    }
+    const MyContainer<T> container(std::move(values));
+
+    std::ostringstream fast;
+    fast << container;
+    std::ostringstream slow;
+    print_each(slow, container);
+    bool identical = fast.str() == slow.str();
+    double megabytes = static_cast<double>(fast.str().size()) / 1e6;
+
+    double string_new = best_seconds([&]() { std::ostringstream os; os << container; });
+    double string_old = best_seconds([&]() { std::ostringstream os; print_each(os, container); });
+    std::ofstream null_stream("/dev/null");
+    double null_new = best_seconds([&]() { null_stream << container; null_stream.flush(); });
+    double null_old = best_seconds([&]() { print_each(null_stream, container); null_stream.flush(); });
+
+    std::cout << name << " (" << megabytes << " MB, " << (identical ? "identical" : "DIFFERENT") << ")\n"
+              << "  stringstream  per-element " << string_old * 1e3 << " ms  to_chars " << string_new * 1e3
+              << " ms  (" << megabytes / string_new << " MB/s, " << string_old / string_new << "x)\n"
+              << "  /dev/null     per-element " << null_old * 1e3 << " ms  to_chars " << null_new * 1e3
+              << " ms  (" << megabytes / null_new << " MB/s, " << null_old / null_new << "x)\n";
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? static_cast<size_t>(std::strtod(argv[1], nullptr)) : 10000000;
+    std::cout << "Printing " << n << " elements\n";
+    bench_type<int>("int", n, [](uint64_t i) { return static_cast<int>(detail::mix64(i)); });
+    bench_type<long long>("long long", n, [](uint64_t i) { return static_cast<long long>(detail::mix64(i)); });
+    bench_type<double>("double", n, [](uint64_t i) { return static_cast<double>(detail::mix64(i) >> 11) * 1e-6; });
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Compares the previous way of loading numbers (std::istream >> and add() per
+// value) with MyContainer::from_text() on one thread and split across a
+// thread pool, and with from_file() on a memory-mapped file, for int and
+// double columns. Reports time and input bandwidth and checks that every
+// loader produced the same elements.
+//
+// Usage: ./load_bench [lines]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../MyContainer.hpp"
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+template<typename Load>
+static double best_seconds(Load load) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        auto start = Clock::now();
+        load();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+/**
+ * @brief The previous loader: stream extraction and one add() per value.
+ */
+template<typename T>
+static MyContainer<T> load_each(const std::string& text) {
+    std::istringstream in(text);
+    MyContainer<T> container;
+    T value;
+    while (in >> value) {
+        container.add(value);
+    }
+    return container;
+}
+
+template<typename T>
+static void bench_type(const char* name, size_t lines, T (*make)(uint64_t)) {
+    std::ostringstream out;
+    out.precision(17);
+    for (size_t i = 0; i < lines; ++i) {
+        out << make(i) << '\n';
+    }
+    const std::string text = out.str();
+    const double megabytes = static_cast<double>(text.size()) / 1e6;
+    const std::string path = std::string("load_bench_") + name + ".txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+
+    ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    LoadOptions sequential;
+    sequential.parallel = false;
+    LoadOptions parallel;
+    parallel.pool = &pool;
+
+    const std::vector<T> expected = load_each<T>(text).getData();
+    bool identical = MyContainer<T>::from_text(text, parallel).getData() == expected &&
+                     MyContainer<T>::from_file(path, parallel).getData() == expected;
+
+    double each = best_seconds([&]() { load_each<T>(text); });
+    double single = best_seconds([&]() { MyContainer<T>::from_text(text, sequential); });
+    double threaded = best_seconds([&]() { MyContainer<T>::from_text(text, parallel); });
+    double mapped = best_seconds([&]() { MyContainer<T>::from_file(path, parallel); });
+    std::remove(path.c_str());
+
+    std::cout << name << " (" << megabytes << " MB, " << (identical ? "identical" : "DIFFERENT") << ")\n"
+              << "  istream >> + add  " << each * 1e3 << " ms  (" << megabytes / each << " MB/s)\n"
+              << "  from_text 1 thread " << single * 1e3 << " ms  (" << megabytes / single << " MB/s, "
+              << each / single << "x)\n"
+              << "  from_text " << pool.size() + 1 << " threads " << threaded * 1e3 << " ms  ("
+              << megabytes / threaded << " MB/s, " << each / threaded << "x)\n"
+              << "  from_file mmap    " << mapped * 1e3 << " ms  (" << megabytes / mapped << " MB/s)\n";
+}
+
+int main(int argc, char** argv) {
+    size_t lines = argc > 1 ? static_cast<size_t>(std::strtod(argv[1], nullptr)) : 10000000;
+    std::cout << "Loading " << lines << " lines\n";
+    bench_type<int>("int", lines, [](uint64_t i) { return static_cast<int>(detail::mix64(i)); });
+    bench_type<double>("double", lines, [](uint64_t i) { return static_cast<double>(detail::mix64(i) >> 11) * 1e-6; });
+    return 0;
+}
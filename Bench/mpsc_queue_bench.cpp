@@ -0,0 +1,113 @@
+// Compares producer-side enqueue cost of a mutex-guarded MyContainer against
+// an MpscQueue drained in batches by a single consumer thread, for 1 to 16
+// producers. Reports end-to-end throughput (including the final drain) and
+// p50/p99 enqueue latency (every 64th enqueue is timed individually).
+//
+// Usage: ./mpsc_queue_bench [total_elements] [queue_capacity]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../MyContainer.hpp"
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+struct RunResult {
+    double seconds = 0.0;
+    std::vector<double> latencies_ns;
+};
+
+template<typename EnqueueFn>
+static RunResult run_producers(size_t producers, size_t total, EnqueueFn enqueue) {
+    std::vector<std::vector<double>> samples(producers);
+    std::vector<std::thread> threads;
+    size_t per_producer = total / producers;
+    auto start = Clock::now();
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&enqueue, &samples, p, per_producer]() {
+            samples[p].reserve(per_producer / 64 + 1);
+            for (size_t i = 0; i < per_producer; ++i) {
+                int value = static_cast<int>(p * per_producer + i);
+                if (i % 64 == 0) {
+                    auto before = Clock::now();
+                    enqueue(value);
+                    samples[p].push_back(std::chrono::duration<double, std::nano>(Clock::now() - before).count());
+                } else {
+                    enqueue(value);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& s : samples) {
+        result.latencies_ns.insert(result.latencies_ns.end(), s.begin(), s.end());
+    }
+    return result;
+}
+
+static double percentile(std::vector<double>& values, double q) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t k = static_cast<size_t>(q * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(k), values.end());
+    return values[k];
+}
+
+static void report(const char* name, RunResult& result, size_t total) {
+    std::cout << " " << name << "=" << (total / result.seconds / 1e6) << " Mops/s"
+              << " p50=" << percentile(result.latencies_ns, 0.50) << "ns"
+              << " p99=" << percentile(result.latencies_ns, 0.99) << "ns";
+}
+
+int main(int argc, char** argv) {
+    size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t capacity = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 65536;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+              << " queue capacity: " << capacity << std::endl;
+    for (size_t producers = 1; producers <= 16; producers *= 2) {
+        size_t produced = total / producers * producers;
+
+        MyContainer<int> locked;
+        std::mutex lock;
+        RunResult mutex_result = run_producers(producers, produced, [&](int value) {
+            std::lock_guard<std::mutex> guard(lock);
+            locked.add(value);
+        });
+
+        MyContainer<int> drained;
+        MpscQueue<int> queue(capacity);
+        std::atomic<bool> producing{true};
+        std::thread consumer([&]() {
+            while (producing.load(std::memory_order_acquire)) {
+                if (drained.drain(queue, 4096) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            while (drained.drain(queue) != 0) {
+            }
+        });
+        auto queue_start = Clock::now();
+        RunResult queue_result = run_producers(producers, produced, [&](int value) {
+            queue.push(value);
+        });
+        producing.store(false, std::memory_order_release);
+        consumer.join();
+        queue_result.seconds = std::chrono::duration<double>(Clock::now() - queue_start).count();
+
+        std::cout << "producers=" << producers;
+        report("mutex", mutex_result, produced);
+        report("mpsc", queue_result, produced);
+        std::cout << " (" << locked.size() << "/" << drained.size() << " elements)" << std::endl;
+    }
+    return 0;
+}
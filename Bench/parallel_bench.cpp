@@ -0,0 +1,79 @@
+// Scaling of MyContainer::parallel_transform / parallel_for_each against the
+// serial iterator loop, per traversal order, for thread pools of 1 to
+// 2 x hardware threads. The work per element is a few multiply-adds, so the
+// permuted orders are bound by memory latency rather than arithmetic.
+//
+// Usage: ./parallel_bench [elements]
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../MyContainer.hpp"
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+static long long work(int value) {
+    long long x = value;
+    for (int i = 0; i < 8; ++i) {
+        x = x * 6364136223846793005LL + 1442695040888963407LL;
+    }
+    return x;
+}
+
+template<typename F>
+static double best_ms(F f) {
+    double best = 1e300;
+    for (int run = 0; run < 3; ++run) {
+        auto start = Clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+template<typename Order, typename Policy>
+static void run_order(const char* name, const MyContainer<int>& c, Order first, Order last, const Policy& policy) {
+    std::vector<long long> out(c.size());
+    double serial = best_ms([&]() {
+        size_t k = 0;
+        for (auto it = first; it != last; ++it) {
+            out[k++] = work(*it);
+        }
+    });
+    std::cout << name << ": serial=" << serial << "ms";
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= 2 * hardware; threads *= 2) {
+        // The calling thread joins in, so threads - 1 workers give `threads` threads.
+        std::unique_ptr<ThreadPool> pool = threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr;
+        double transform = best_ms([&]() {
+            c.parallel_transform(policy, out.data(), [](int v) { return work(v); }, pool.get());
+        });
+        std::atomic<long long> checksum{0};
+        double for_each = best_ms([&]() {
+            c.parallel_for_each(policy, [&](int v) { checksum.fetch_add(work(v) & 1, std::memory_order_relaxed); }, pool.get());
+        });
+        std::cout << " | t=" << threads << " transform=" << transform << "ms (x" << serial / transform << ")"
+                  << " for_each=" << for_each << "ms";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (size_t{1} << 22);
+    std::vector<int> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<int>((i * 2654435761u) % n);
+    }
+    MyContainer<int> c(std::move(values));
+    std::cout << "elements: " << n << " hardware threads: " << std::thread::hardware_concurrency()
+              << " grain: " << detail::parallel_grain << std::endl;
+    run_order("insertion", c, c.begin_order(), c.end_order(), InsertionMapping());
+    run_order("ascending", c, c.begin_ascending_order(), c.end_ascending_order(), AscendingMapping());
+    run_order("middle_out", c, c.begin_middle_out_order(), c.end_middle_out_order(), MiddleOutMapping());
+    run_order("random", c, c.begin_random_order(7), c.end_random_order(7), RandomMapping(7));
+    return 0;
+}
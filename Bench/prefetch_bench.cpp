@@ -0,0 +1,87 @@
+// Measures gather throughput of permuted (ascending) traversal with and
+// without software prefetching, for double and a 64-byte struct.
+//
+// Usage: ./prefetch_bench [max_elements]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../MyContainer.hpp"
+
+using namespace MyContainerNamespace;
+
+struct Payload64 {
+    double key;
+    double rest[7];
+
+    bool operator<(const Payload64& other) const { return key < other.key; }
+    bool operator>(const Payload64& other) const { return key > other.key; }
+};
+
+static double value_of(double x) { return x; }
+static double value_of(const Payload64& x) { return x.key; }
+
+template<typename T>
+static T make_value(std::mt19937_64& rng) {
+    T value{};
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    if constexpr (std::is_same_v<T, double>) {
+        value = dist(rng);
+    } else {
+        value.key = dist(rng);
+    }
+    return value;
+}
+
+template<size_t Distance, typename T>
+static double time_gather(const MyContainer<T>& c, std::vector<T>& out, double& checksum) {
+    auto permutation = c.permutation_for(AscendingMapping());
+    detail::PermutationMap map{permutation->data(), permutation->size()};
+    auto start = std::chrono::steady_clock::now();
+    detail::gather<Distance>(c.getData().data(), map, 0, c.size(), out.data());
+    auto stop = std::chrono::steady_clock::now();
+    checksum += value_of(out[c.size() / 2]);
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(c.size());
+}
+
+template<typename T>
+static void run(const std::string& type_name, size_t n) {
+    std::mt19937_64 rng(12345);
+    std::vector<T> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(make_value<T>(rng));
+    }
+    const MyContainer<T> c(std::move(values));
+    std::vector<T> out(n);
+    double checksum = 0;
+    c.permutation_for(AscendingMapping());
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        checksum += value_of(*it);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double iterator_ns = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(n);
+
+    std::cout << type_name << " n=" << n
+              << " iterator(D=" << detail::prefetch_distance << ")=" << iterator_ns << "ns/elem"
+              << " gather D=0:" << time_gather<0>(c, out, checksum)
+              << " D=4:" << time_gather<4>(c, out, checksum)
+              << " D=8:" << time_gather<8>(c, out, checksum)
+              << " D=16:" << time_gather<16>(c, out, checksum)
+              << " D=32:" << time_gather<32>(c, out, checksum)
+              << " D=64:" << time_gather<64>(c, out, checksum)
+              << " ns/elem (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t max_elements = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (size_t{1} << 22);
+    for (size_t n = size_t{1} << 16; n <= max_elements; n <<= 2) {
+        run<double>("double", n);
+        run<Payload64>("payload64", n);
+    }
+    return 0;
+}
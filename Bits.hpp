@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief Number of bits needed to represent x (0 for x == 0).
+         */
+        inline unsigned bit_width(uint64_t x) {
+#if defined(__GNUC__)
+            return x == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(x));
+#else
+            unsigned width = 0;
+            while (x != 0) {
+                x >>= 1;
+                ++width;
+            }
+            return width;
+#endif
+        }
+
+        /**
+         * @brief SplitMix64 finalizer: a fast, well-distributed 64-bit mixing function.
+         */
+        inline uint64_t mix64(uint64_t x) {
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+    }
+
+}
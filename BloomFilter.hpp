@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "Bits.hpp"
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Snapshot of a container's membership filter, see MyContainer::filter_stats().
+     */
+    struct MembershipFilterStats {
+        bool enabled = false;
+        size_t memory_bytes = 0;
+        size_t bits = 0;
+        size_t hash_functions = 0;
+        size_t capacity = 0;
+        double target_false_positive_rate = 0.0;
+        double estimated_false_positive_rate = 0.0;
+        size_t queries = 0;
+        size_t rejected = 0;
+        size_t false_positives = 0;
+        size_t rebuilds = 0;
+    };
+
+    /**
+     * @brief Blocked Bloom filter over 64-bit hashes.
+     *
+     * Every key sets all of its bits inside one 512-bit (cache-line) block,
+     * so a lookup touches a single cache line. Hashes are remixed first, since
+     * std::hash is the identity for integers.
+     */
+    class BloomFilter {
+    private:
+        static constexpr size_t block_bits = 512;
+        static constexpr size_t block_words = block_bits / 64;
+
+        std::vector<uint64_t> words;
+        size_t blocks = 0;
+        unsigned hashes = 1;
+
+        size_t block_of(uint64_t hash) const {
+#if defined(__SIZEOF_INT128__)
+            __extension__ typedef unsigned __int128 wide;
+            return static_cast<size_t>((static_cast<wide>(hash) * blocks) >> 64);
+#else
+            return static_cast<size_t>(hash % blocks);
+#endif
+        }
+
+    public:
+        BloomFilter() = default;
+
+        /**
+         * @brief Constructor for the filter.
+         * @param capacity Number of keys the filter is sized for.
+         * @param false_positive_rate Target false-positive rate at capacity.
+         * @throw std::invalid_argument If the rate is not in (0, 1).
+         */
+        BloomFilter(size_t capacity, double false_positive_rate) {
+            if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+                throw std::invalid_argument("False-positive rate must be in (0, 1)");
+            }
+            const double ln2 = std::log(2.0);
+            double keys = static_cast<double>(std::max<size_t>(capacity, 1));
+            double bits = -keys * std::log(false_positive_rate) / (ln2 * ln2);
+            blocks = std::max<size_t>(1, static_cast<size_t>(std::ceil(bits / block_bits)));
+            double per_key = static_cast<double>(blocks * block_bits) / keys;
+            hashes = static_cast<unsigned>(std::clamp(std::lround(per_key * ln2), 1L, 16L));
+            words.assign(blocks * block_words, 0);
+        }
+
+        /**
+         * @brief Adds a key.
+         * @param hash The key's 64-bit hash.
+         */
+        void insert(uint64_t hash) {
+            uint64_t mixed = detail::mix64(hash);
+            uint64_t* block = words.data() + block_of(mixed) * block_words;
+            uint64_t probe = detail::mix64(mixed);
+            for (unsigned i = 0; i < hashes; ++i) {
+                size_t bit = static_cast<size_t>(probe >> ((i % 7) * 9)) & (block_bits - 1);
+                block[bit / 64] |= uint64_t{1} << (bit % 64);
+                if (i % 7 == 6) {
+                    probe = detail::mix64(probe);
+                }
+            }
+        }
+
+        /**
+         * @brief Tests a key.
+         * @param hash The key's 64-bit hash.
+         * @return False if the key was certainly never inserted.
+         */
+        bool may_contain(uint64_t hash) const {
+            uint64_t mixed = detail::mix64(hash);
+            const uint64_t* block = words.data() + block_of(mixed) * block_words;
+            uint64_t probe = detail::mix64(mixed);
+            for (unsigned i = 0; i < hashes; ++i) {
+                size_t bit = static_cast<size_t>(probe >> ((i % 7) * 9)) & (block_bits - 1);
+                if ((block[bit / 64] & (uint64_t{1} << (bit % 64))) == 0) {
+                    return false;
+                }
+                if (i % 7 == 6) {
+                    probe = detail::mix64(probe);
+                }
+            }
+            return true;
+        }
+
+        size_t bit_count() const {
+            return words.size() * 64;
+        }
+
+        size_t hash_count() const {
+            return hashes;
+        }
+
+        size_t memory_bytes() const {
+            return words.capacity() * sizeof(uint64_t);
+        }
+
+        /**
+         * @brief Estimates the current false-positive rate from the fraction of set bits.
+         * @return Approximately (set bits / bits) ^ hashes.
+         */
+        double estimated_false_positive_rate() const {
+            if (words.empty()) {
+                return 0.0;
+            }
+            size_t set = 0;
+            for (uint64_t word : words) {
+#if defined(__GNUC__)
+                set += static_cast<size_t>(__builtin_popcountll(word));
+#else
+                for (; word != 0; word &= word - 1) {
+                    ++set;
+                }
+#endif
+            }
+            return std::pow(static_cast<double>(set) / static_cast<double>(bit_count()), hashes);
+        }
+    };
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Bits.hpp"
+#include "MyContainer.hpp"
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Ingestion-side container that many threads can add() to concurrently.
+     *
+     * Producers are spread over shards (one per thread, round-robin), and each
+     * shard hands out slots with a single atomic fetch_add, so adds never take
+     * a lock. Shard storage grows in chunks of doubling size that are never
+     * moved, so a reserved slot stays valid while other producers append.
+     * Once producers are done, freeze() moves everything into an ordinary
+     * MyContainer, where all traversal orders work unchanged.
+     *
+     * @tparam T The element type.
+     */
+    template<typename T = int>
+    class ConcurrentMyContainer {
+    private:
+        static constexpr size_t first_chunk = 1024;
+        static constexpr size_t max_chunks = 48;
+
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+            std::atomic<bool> ready{false};
+
+            T& value() {
+                return *std::launder(reinterpret_cast<T*>(storage));
+            }
+        };
+
+        struct alignas(64) Shard {
+            std::atomic<size_t> next{0};
+            std::atomic<Slot*> chunks[max_chunks] = {};
+        };
+
+        std::vector<Shard> shards;
+
+        static size_t chunk_capacity(size_t chunk) {
+            return first_chunk << chunk;
+        }
+
+        /**
+         * @brief Shard used by the calling thread, fixed per thread.
+         */
+        size_t shard_of_this_thread() const {
+            static std::atomic<size_t> next_thread{0};
+            thread_local size_t thread_number = next_thread.fetch_add(1, std::memory_order_relaxed);
+            return thread_number % shards.size();
+        }
+
+        /**
+         * @brief Finds (allocating on first touch) the storage of a slot number.
+         * Chunk c holds slots [first_chunk * (2^c - 1), first_chunk * (2^(c+1) - 1)).
+         */
+        Slot& locate(Shard& shard, size_t slot) {
+            size_t chunk = detail::bit_width(slot / first_chunk + 1) - 1;
+            size_t offset = slot - first_chunk * ((size_t{1} << chunk) - 1);
+            Slot* storage = shard.chunks[chunk].load(std::memory_order_acquire);
+            if (storage == nullptr) {
+                Slot* fresh = new Slot[chunk_capacity(chunk)];
+                if (shard.chunks[chunk].compare_exchange_strong(storage, fresh, std::memory_order_acq_rel)) {
+                    storage = fresh;
+                } else {
+                    delete[] fresh;
+                }
+            }
+            return storage[offset];
+        }
+
+        /**
+         * @brief Visits (and optionally destroys) every constructed element, then frees all chunks.
+         */
+        template<typename F>
+        void drain(F f) {
+            for (Shard& shard : shards) {
+                size_t used = shard.next.load(std::memory_order_acquire);
+                for (size_t chunk = 0; chunk < max_chunks; ++chunk) {
+                    Slot* storage = shard.chunks[chunk].load(std::memory_order_acquire);
+                    if (storage == nullptr) {
+                        continue;
+                    }
+                    size_t begin = first_chunk * ((size_t{1} << chunk) - 1);
+                    size_t count = std::min(chunk_capacity(chunk), used > begin ? used - begin : 0);
+                    for (size_t i = 0; i < count; ++i) {
+                        if (storage[i].ready.load(std::memory_order_acquire)) {
+                            f(storage[i].value());
+                            storage[i].value().~T();
+                        }
+                    }
+                    delete[] storage;
+                    shard.chunks[chunk].store(nullptr, std::memory_order_relaxed);
+                }
+                shard.next.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor for the container.
+         * @param shard_count Number of independent append shards (default: one per hardware thread, at least 4).
+         */
+        explicit ConcurrentMyContainer(size_t shard_count = std::max<size_t>(4, std::thread::hardware_concurrency()))
+            : shards(std::max<size_t>(1, shard_count)) {}
+
+        ConcurrentMyContainer(const ConcurrentMyContainer&) = delete;
+        ConcurrentMyContainer& operator=(const ConcurrentMyContainer&) = delete;
+
+        /**
+         * @brief Destructor. Destroys all elements not yet frozen out.
+         */
+        ~ConcurrentMyContainer() {
+            drain([](T&) {});
+        }
+
+        /**
+         * @brief Adds an element. Safe to call from any number of threads at once.
+         * @param element The element to add.
+         */
+        void add(const T& element) {
+            Shard& shard = shards[shard_of_this_thread()];
+            size_t slot = shard.next.fetch_add(1, std::memory_order_relaxed);
+            Slot& target = locate(shard, slot);
+            new (target.storage) T(element);
+            target.ready.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Returns the number of reserved slots (exact once producers are quiescent).
+         * @return The number of elements added.
+         */
+        size_t size() const {
+            size_t total = 0;
+            for (const Shard& shard : shards) {
+                total += shard.next.load(std::memory_order_acquire);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Returns the number of append shards.
+         * @return The shard count.
+         */
+        size_t shard_count() const {
+            return shards.size();
+        }
+
+        /**
+         * @brief Moves every element into a regular MyContainer and empties this one.
+         *
+         * Must not run concurrently with add(). Elements appear grouped by
+         * shard, in per-shard insertion order.
+         * @return The sealed container.
+         */
+        MyContainer<T> freeze() {
+            std::vector<T> out;
+            out.reserve(size());
+            drain([&out](T& element) { out.push_back(std::move(element)); });
+            return MyContainer<T>(std::move(out));
+        }
+    };
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "OrderedIterator.hpp"
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Adapts a callable f(k, n) -> index into a closed-form mapping policy.
+     *
+     * Example (stride-3 order over n elements when 3 does not divide n):
+     * @code
+     * auto stride = make_index_order([](size_t k, size_t n) { return (k * 3) % n; });
+     * for (auto it = c.begin_custom_order(stride); it != c.end_custom_order(stride); ++it) { ... }
+     * @endcode
+     */
+    template<typename F>
+    struct IndexOrder {
+        F f;
+
+        size_t index_at(size_t k, size_t n) const {
+            return f(k, n);
+        }
+    };
+
+    /**
+     * @brief Adapts a callable f(data, indices) into a permutation mapping policy.
+     *
+     * The callable receives the container's elements and must fill indices with
+     * a permutation of [0, data.size()); any other output makes the traversal
+     * throw std::invalid_argument. Capture-less callables are cached by
+     * the container until its next mutation; capturing ones are rebuilt per
+     * begin iterator.
+     */
+    template<typename F>
+    struct PermutationOrder {
+        static constexpr bool cacheable = std::is_empty_v<F>;
+
+        F f;
+
+        template<typename T>
+        void build(const std::vector<T>& data, std::vector<size_t>& indices) const {
+            f(data, indices);
+        }
+    };
+
+    /**
+     * @brief Creates a closed-form custom order from f(k, n).
+     * @param f Callable returning the data index visited at position k of n.
+     * @return The mapping policy.
+     */
+    template<typename F>
+    IndexOrder<F> make_index_order(F f) {
+        return IndexOrder<F>{std::move(f)};
+    }
+
+    /**
+     * @brief Creates a permutation-based custom order from f(data, indices).
+     * @param f Callable filling indices with the traversal order.
+     * @return The mapping policy.
+     */
+    template<typename F>
+    PermutationOrder<F> make_permutation_order(F f) {
+        return PermutationOrder<F>{std::move(f)};
+    }
+
+}
@@ -1,94 +1,40 @@
 #pragma once
-//#include "MyContainer.hpp"
 #include <vector>
 #include <algorithm>
+#include "OrderedIterator.hpp"
+#include "Instrumentation.hpp"
 
 namespace MyContainerNamespace {
 
-    template<typename T>
-    class MyContainer;
-
-   template<typename T>
-class DescendingOrder {
-    private:
-        const MyContainer<T>& container;
-        std::vector<size_t> indices;
-        size_t current_index;
+    /**
+     * @brief Mapping policy that visits elements from largest to smallest.
+     */
+    struct DescendingMapping {
+        static constexpr bool trusted = true;
+        static constexpr const char* trace_name = "DescendingOrder index build";
 
-    public:
         /**
-         * @brief Constructor for the DescendingOrder.
-         * @param cont Reference to the container.
-         * @param pos The starting position (default is 0).
+         * @brief Builds the descending permutation of the data.
+         * @param data The container's elements.
+         * @param indices Output: data indices sorted by descending value.
          */
-        explicit DescendingOrder(const MyContainer<T>& cont, size_t pos = 0)
-            : container(cont), current_index(pos) {
-                
-            if (container.empty()) {
-                return;
-            }
-            indices.resize(container.size());
-            for (size_t i = 0; i < container.size(); ++i) {
+        template<typename T>
+        void build(const std::vector<T>& data, std::vector<size_t>& indices) const {
+            indices.resize(data.size());
+            for (size_t i = 0; i < data.size(); ++i) {
                 indices[i] = i;
             }
-            std::sort(indices.begin(), indices.end(),
-                [this](size_t a, size_t b) {
-                    return container.getData()[a] > container.getData()[b];
+            detail::sort_indices(indices,
+                [&data](size_t a, size_t b) {
+                    return data[a] > data[b];
                 });
         }
-        /**
-         * @brief Access current element.
-         * @return Reference to the current element.
-         * @throw std::out_of_range If out of bounds
-         */
-        const T& operator*() const {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Iterator out of bounds");
-            }
-            return container.getData()[indices[current_index]];
-        }
-        /**
-         * @brief Pre-increment operator. Advance to next position.
-         * @return Reference after increment.
-         * @throw std::out_of_range If incrementing past end
-         */
-        DescendingOrder& operator++() {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
-            }
-            ++current_index;
-            return *this;
-        }
-        /**
-         * @brief Post-increment operator. Advance to next position.
-         * @return Copy of the iterator before increment.
-         * @throw std::out_of_range If incrementing past end
-         */
-        DescendingOrder operator++(int) {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
-            }
-            DescendingOrder temp = *this;
-            ++current_index;
-            return temp;
-        }
-        /**
-         * @brief Equality operator.
-         * @param other The other iterator to compare with.
-         * @return True if both iterators are equal, false otherwise.
-         */
-        bool operator==(const DescendingOrder& other) const {
-            return current_index == other.current_index && &container == &other.container;
-        }
-        /**
-         * @brief Inequality operator.
-         * @param other The other iterator to compare with.
-         * @return True if both iterators are not equal, false otherwise.
-         */
-        bool operator!=(const DescendingOrder& other) const {
-            return !(*this == other);
-        }
-
     };
 
-}
\ No newline at end of file
+    /**
+     * @brief Iterator over the container in descending order.
+     */
+    template<typename T>
+    using DescendingOrder = OrderedIterator<T, DescendingMapping>;
+
+}
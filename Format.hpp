@@ -0,0 +1,98 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <locale>
+#include <ostream>
+#include <system_error>
+#include <type_traits>
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief Whether T prints as a number that std::to_chars can produce.
+         * Character types and bool print as characters or words, so they are excluded.
+         */
+        template<typename T>
+        inline constexpr bool to_chars_formattable =
+            (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+             !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> &&
+             !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>) ||
+            std::is_floating_point_v<T>;
+
+        /**
+         * @brief Whether os would print a T exactly as std::to_chars does: default
+         * flags, no field width, a non-negative precision and the classic locale
+         * (no digit grouping).
+         * For floating point the precision is honoured, as "%.<precision>g".
+         * @param os The stream about to be written to.
+         */
+        inline bool default_number_formatting(const std::ostream& os) {
+            return os.flags() == (std::ios_base::skipws | std::ios_base::dec) && os.width() == 0 &&
+                   os.precision() >= 0 && os.getloc() == std::locale::classic();
+        }
+
+        /**
+         * @brief Formats one number at out.
+         * @return One past the last character written, or nullptr if it did not fit before end.
+         */
+        template<typename T>
+        char* format_number(char* out, char* end, T value, int precision) {
+            std::to_chars_result result;
+            if constexpr (std::is_floating_point_v<T>) {
+                result = std::to_chars(out, end, value, std::chars_format::general, precision);
+            } else {
+                result = std::to_chars(out, end, value);
+            }
+            return result.ec == std::errc() ? result.ptr : nullptr;
+        }
+
+        /**
+         * @brief Writes "[a, b, c]" for numbers through a local buffer, flushed
+         * in large writes. Output is byte-identical to inserting each element
+         * with operator<< under default_number_formatting().
+         * @param os The stream to write to.
+         * @param data The elements.
+         * @param n Number of elements.
+         */
+        template<typename T>
+        void write_number_list(std::ostream& os, const T* data, size_t n) {
+            char buffer[1 << 16];
+            char* const end = buffer + sizeof(buffer);
+            char* out = buffer;
+            int precision = static_cast<int>(os.precision());
+            auto flush = [&]() {
+                os.write(buffer, out - buffer);
+                out = buffer;
+            };
+
+            *out++ = '[';
+            for (size_t i = 0; i < n; ++i) {
+                if (i != 0) {
+                    if (end - out < 2) {
+                        flush();
+                    }
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                char* next = format_number(out, end, data[i], precision);
+                if (next == nullptr) {
+                    flush();
+                    next = format_number(out, end, data[i], precision);
+                    if (next == nullptr) {
+                        // Longer than the whole buffer (a huge precision): let the stream format it.
+                        os << data[i];
+                        continue;
+                    }
+                }
+                out = next;
+            }
+            if (out == end) {
+                flush();
+            }
+            *out++ = ']';
+            flush();
+        }
+    }
+
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief How many positions ahead permuted traversals prefetch (0 disables).
+ */
+#ifndef MYCONTAINER_PREFETCH_DISTANCE
+#define MYCONTAINER_PREFETCH_DISTANCE 16
+#endif
+
+namespace MyContainerNamespace {
+
+    struct InsertionMapping;
+    struct ReverseMapping;
+
+    namespace detail {
+        inline constexpr size_t prefetch_distance = MYCONTAINER_PREFETCH_DISTANCE;
+
+        /**
+         * @brief Hints the CPU to start loading the cache line holding address.
+         */
+        inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+            __builtin_prefetch(address, 0, 3);
+#else
+            (void)address;
+#endif
+        }
+
+        /**
+         * @brief Memory direction of a mapping policy: +1 or -1 for orders that
+         * walk the data contiguously, 0 for permuted orders.
+         */
+        template<typename Policy>
+        struct contiguous_direction : std::integral_constant<int, 0> {};
+
+        template<>
+        struct contiguous_direction<InsertionMapping> : std::integral_constant<int, 1> {};
+
+        template<>
+        struct contiguous_direction<ReverseMapping> : std::integral_constant<int, -1> {};
+
+        /**
+         * @brief Position-to-index map for a closed-form policy over n elements.
+         */
+        template<typename Policy>
+        struct ClosedFormMap {
+            const Policy& policy;
+            size_t n;
+
+            size_t operator()(size_t k) const {
+                size_t index = policy.index_at(k, n);
+                if (index >= n) {
+                    throw std::out_of_range("Mapping produced index out of range");
+                }
+                return index;
+            }
+        };
+
+        /**
+         * @brief Position-to-index map backed by a materialized permutation.
+         */
+        struct PermutationMap {
+            const size_t* indices;
+            size_t n;
+
+            size_t operator()(size_t k) const {
+                return indices[k];
+            }
+        };
+
+        /**
+         * @brief Copies the elements at positions [first, first + count) of an order.
+         * @param data The container's elements.
+         * @param map Position-to-index map of the order.
+         * @param first The first traversal position.
+         * @param count Number of positions to copy.
+         * @param out Destination with room for count elements.
+         */
+        template<size_t Distance = prefetch_distance, typename T, typename Map>
+        void gather(const T* data, const Map& map, size_t first, size_t count, T* out) {
+            for (size_t j = 0; j < count; ++j) {
+                out[j] = data[map(first + j)];
+            }
+        }
+
+        /**
+         * @brief Gather through a permutation, prefetching Distance positions ahead.
+         *
+         * The permutation is known up front, so the dependent load
+         * data[indices[k + Distance]] can be issued long before it is needed.
+         */
+        template<size_t Distance = prefetch_distance, typename T>
+        void gather(const T* data, const PermutationMap& map, size_t first, size_t count, T* out) {
+            size_t end = first + count;
+            size_t prefetch_end = (Distance > 0 && map.n > Distance) ? std::min(end, map.n - Distance) : first;
+            size_t k = first;
+            for (; k < prefetch_end; ++k) {
+                prefetch(data + map.indices[k + Distance]);
+                out[k - first] = data[map.indices[k]];
+            }
+            for (; k < end; ++k) {
+                out[k - first] = data[map.indices[k]];
+            }
+        }
+
+        /**
+         * @brief Calls f(k, element) for the positions k in [first, first + count) of an order.
+         * @param data The container's elements.
+         * @param map Position-to-index map of the order.
+         * @param first The first traversal position.
+         * @param count Number of positions to visit.
+         * @param f Callable taking (size_t position, const T&).
+         */
+        template<size_t Distance = prefetch_distance, typename T, typename Map, typename F>
+        void visit(const T* data, const Map& map, size_t first, size_t count, F&& f) {
+            for (size_t k = first; k < first + count; ++k) {
+                f(k, data[map(k)]);
+            }
+        }
+
+        /**
+         * @brief visit() through a permutation, prefetching Distance positions ahead like gather().
+         */
+        template<size_t Distance = prefetch_distance, typename T, typename F>
+        void visit(const T* data, const PermutationMap& map, size_t first, size_t count, F&& f) {
+            size_t end = first + count;
+            size_t prefetch_end = (Distance > 0 && map.n > Distance) ? std::min(end, map.n - Distance) : first;
+            size_t k = first;
+            for (; k < prefetch_end; ++k) {
+                prefetch(data + map.indices[k + Distance]);
+                f(k, data[map.indices[k]]);
+            }
+            for (; k < end; ++k) {
+                f(k, data[map.indices[k]]);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#ifdef MYCONTAINER_INSTRUMENT
+#include <chrono>
+#include <mutex>
+#endif
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Cost of the permutation (index) builds of a container, see MyContainer::stats().
+     *
+     * Only collected when MYCONTAINER_INSTRUMENT is defined; otherwise
+     * enabled is false and every counter stays zero.
+     */
+    struct InstrumentationStats {
+        bool enabled = false;
+        size_t index_builds = 0;
+        size_t comparisons = 0;
+        size_t index_moves = 0;
+        size_t index_bytes = 0;
+        uint64_t build_ns = 0;
+    };
+
+    namespace detail {
+#ifdef MYCONTAINER_INSTRUMENT
+        /**
+         * @brief Running totals of the current thread, read before and after each build.
+         */
+        struct InstrumentCounters {
+            size_t comparisons = 0;
+            size_t index_moves = 0;
+            size_t index_bytes = 0;
+        };
+
+        inline thread_local InstrumentCounters instrument_counters;
+
+        /**
+         * @brief Index whose copies and moves are counted, so the sort's data movement is visible.
+         */
+        struct CountedIndex {
+            size_t value;
+
+            CountedIndex(size_t v) : value(v) {}
+            CountedIndex(const CountedIndex& other) : value(other.value) {
+                ++instrument_counters.index_moves;
+            }
+            CountedIndex& operator=(const CountedIndex& other) {
+                value = other.value;
+                ++instrument_counters.index_moves;
+                return *this;
+            }
+        };
+
+        /**
+         * @brief Accumulates the cost of every build run through record().
+         */
+        class InstrumentSink {
+        private:
+            mutable std::mutex lock;
+            InstrumentationStats totals;
+
+        public:
+            /**
+             * @brief Runs a build, adding its comparisons, moves, index bytes and time to the totals.
+             * @param build Callable performing the build on this thread.
+             * @return What build returns.
+             */
+            template<typename F>
+            auto record(F build) {
+                InstrumentCounters before = instrument_counters;
+                auto start = std::chrono::steady_clock::now();
+                auto result = build();
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                const InstrumentCounters& after = instrument_counters;
+                std::lock_guard<std::mutex> guard(lock);
+                ++totals.index_builds;
+                totals.comparisons += after.comparisons - before.comparisons;
+                totals.index_moves += after.index_moves - before.index_moves;
+                totals.index_bytes += after.index_bytes - before.index_bytes;
+                totals.build_ns += static_cast<uint64_t>(ns);
+                return result;
+            }
+
+            /**
+             * @brief Returns the totals so far.
+             */
+            InstrumentationStats snapshot() const {
+                std::lock_guard<std::mutex> guard(lock);
+                InstrumentationStats stats = totals;
+                stats.enabled = true;
+                return stats;
+            }
+
+            /**
+             * @brief Replaces the totals (used to reset them or carry them over).
+             */
+            void assign(const InstrumentationStats& stats) {
+                std::lock_guard<std::mutex> guard(lock);
+                totals = stats;
+            }
+        };
+#endif
+
+        /**
+         * @brief Sorts a permutation by comparing the elements its indices refer to.
+         *
+         * With MYCONTAINER_INSTRUMENT the comparisons and index moves are
+         * counted (the sort runs over counted copies of the indices, so it is
+         * slower); otherwise this is exactly std::sort.
+         * @param indices The indices to sort.
+         * @param less Strict weak ordering on indices.
+         */
+        template<typename Less>
+        void sort_indices(std::vector<size_t>& indices, Less less) {
+#ifdef MYCONTAINER_INSTRUMENT
+            std::vector<CountedIndex> counted(indices.begin(), indices.end());
+            std::sort(counted.begin(), counted.end(), [&less](const CountedIndex& a, const CountedIndex& b) {
+                ++instrument_counters.comparisons;
+                return less(a.value, b.value);
+            });
+            for (size_t i = 0; i < indices.size(); ++i) {
+                indices[i] = counted[i].value;
+            }
+#else
+            std::sort(indices.begin(), indices.end(), less);
+#endif
+        }
+
+        /**
+         * @brief Records an index buffer of the given number of entries (no-op unless instrumented).
+         * @param entries Number of size_t entries in the buffer.
+         */
+        inline void note_index_buffer([[maybe_unused]] size_t entries) {
+#ifdef MYCONTAINER_INSTRUMENT
+            instrument_counters.index_bytes += entries * sizeof(size_t);
+#endif
+        }
+    }
+
+}
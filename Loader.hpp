@@ -0,0 +1,369 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "Parallel.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYCONTAINER_HAS_MMAP 1
+#endif
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief How MyContainer::from_text() and from_file() read their input.
+     *
+     * The input is split into lines ('\n', with an optional '\r' before it)
+     * and every line into fields at delimiter. Spaces and tabs around a field
+     * are ignored, as are blank lines; a space or tab delimiter splits at any
+     * run of spaces and tabs. With parallel set, large inputs are parsed on
+     * pool (the default pool on multi-core machines when null).
+     */
+    struct LoadOptions {
+        /**
+         * @brief Value of column meaning "every non-empty field of every line".
+         */
+        static constexpr size_t all_fields = static_cast<size_t>(-1);
+
+        size_t column = 0;
+        char delimiter = ',';
+        bool header = false;
+        bool parallel = true;
+        ThreadPool* pool = nullptr;
+
+        /**
+         * @brief Options for whitespace-separated values, any number per line.
+         * @return The options.
+         */
+        static LoadOptions whitespace() {
+            LoadOptions options;
+            options.column = all_fields;
+            options.delimiter = ' ';
+            return options;
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Inputs smaller than this per extra thread are parsed on the calling thread.
+         */
+        inline constexpr size_t load_chunk_bytes = size_t{1} << 16;
+
+        /**
+         * @brief Number of bytes equal to c in [first, last), eight at a time.
+         *
+         * Each word marks its matching bytes with a 1 in the byte's low bit;
+         * the marks are summed bytewise for up to 255 words and then folded.
+         */
+        inline size_t count_byte(const char* first, const char* last, char c) {
+            const uint64_t ones = 0x0101010101010101ULL;
+            const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+            const uint64_t pattern = ones * static_cast<unsigned char>(c);
+            size_t count = 0;
+            while (static_cast<size_t>(last - first) >= 8) {
+                size_t words = std::min<size_t>(static_cast<size_t>(last - first) / 8, 255);
+                uint64_t sums = 0;
+                for (size_t w = 0; w < words; ++w, first += 8) {
+                    uint64_t word;
+                    std::memcpy(&word, first, 8);
+                    word ^= pattern;
+                    // High bit of each byte set iff the byte is non-zero.
+                    uint64_t nonzero = ((word & low7) + low7) | word;
+                    sums += (~nonzero >> 7) & ones;
+                }
+                uint64_t pairs = (sums & 0x00FF00FF00FF00FFULL) + ((sums >> 8) & 0x00FF00FF00FF00FFULL);
+                count += static_cast<size_t>((pairs * 0x0001000100010001ULL) >> 48);
+            }
+            return count + static_cast<size_t>(std::count(first, last, c));
+        }
+
+        inline bool is_blank(char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        /**
+         * @brief End of the field starting at first: the next delimiter, or last if there is none.
+         */
+        inline const char* field_end(const char* first, const char* last, char delimiter) {
+            if (delimiter == ' ' || delimiter == '\t') {
+                return std::find_if(first, last, [](char c) { return c == ' ' || c == '\t'; });
+            }
+            const char* end = static_cast<const char*>(std::memchr(first, delimiter, static_cast<size_t>(last - first)));
+            return end ? end : last;
+        }
+
+        /**
+         * @brief Whether fields are parsed with std::from_chars.
+         */
+        template<typename T>
+        inline constexpr bool from_chars_parsable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+        /**
+         * @brief Parses a T from the front of [first, last).
+         * @return One past the parsed characters (last for non-numeric T, which
+         * take the whole range), or nullptr if no T starts at first.
+         */
+        template<typename T>
+        const char* parse_value(const char* first, const char* last, T& out) {
+            if constexpr (from_chars_parsable<T>) {
+                if (last - first > 1 && *first == '+' && first[1] != '-') {
+                    ++first;
+                }
+                std::from_chars_result result = std::from_chars(first, last, out);
+                return result.ec == std::errc() ? result.ptr : nullptr;
+            } else {
+                static_assert(std::is_constructible_v<T, std::string_view>,
+                              "Loading needs an arithmetic type or one constructible from std::string_view");
+                out = T(std::string_view(first, static_cast<size_t>(last - first)));
+                return last;
+            }
+        }
+
+        /**
+         * @brief Upper bound on the values in [first, last): one per line, or
+         * one per field when every field is loaded.
+         */
+        inline size_t count_values(const char* first, const char* last, const LoadOptions& options) {
+            size_t count = count_byte(first, last, '\n') + 1;
+            if (options.column == LoadOptions::all_fields) {
+                count += static_cast<size_t>(std::count_if(first, last, [&](char c) {
+                    return c == options.delimiter || (options.delimiter == ' ' && c == '\t') ||
+                           (options.delimiter == '\t' && c == ' ');
+                }));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Parses the lines in [first, last) and appends the values to out.
+         * @return nullptr on success, otherwise the start of the offending field or line.
+         */
+        template<typename T>
+        const char* parse_lines(const char* first, const char* last, const LoadOptions& options, std::vector<T>& out) {
+            const char* line = first;
+            while (line < last) {
+                const char* line_end = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(last - line)));
+                if (line_end == nullptr) {
+                    line_end = last;
+                }
+                const char* start = line;
+                while (start < line_end && is_blank(*start)) ++start;
+                if (start == line_end) {
+                    line = line_end + 1;
+                    continue;
+                }
+                size_t field = 0;
+                bool found = false;
+                while (start <= line_end) {
+                    if constexpr (from_chars_parsable<T>) {
+                        // The selected column of a numeric type: from_chars finds the field's end itself.
+                        if (field == options.column) {
+                            while (start < line_end && is_blank(*start)) ++start;
+                            T value{};
+                            const char* end = parse_value(start, line_end, value);
+                            const char* rest = end ? end : line_end;
+                            while (rest < line_end && is_blank(*rest)) ++rest;
+                            bool separated = rest == line_end || *rest == options.delimiter ||
+                                             (rest != end && (options.delimiter == ' ' || options.delimiter == '\t'));
+                            if (end == nullptr || !separated) {
+                                return start;
+                            }
+                            out.push_back(value);
+                            found = true;
+                            break;
+                        }
+                    }
+                    const char* end = field_end(start, line_end, options.delimiter);
+                    const char* a = start;
+                    const char* b = end;
+                    while (a < b && is_blank(*a)) ++a;
+                    while (b > a && is_blank(b[-1])) --b;
+                    if (options.column == LoadOptions::all_fields ? a != b : field == options.column) {
+                        T value{};
+                        if (parse_value(a, b, value) != b) {
+                            return a;
+                        }
+                        out.push_back(std::move(value));
+                        found = true;
+                        if (options.column != LoadOptions::all_fields) {
+                            break;
+                        }
+                    }
+                    ++field;
+                    start = end + 1;
+                    if (options.delimiter == ' ' || options.delimiter == '\t') {
+                        while (start < line_end && is_blank(*start)) ++start;
+                    }
+                }
+                if (!found && options.column != LoadOptions::all_fields) {
+                    return line;
+                }
+                line = line_end + 1;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Throws for a parse failure, naming the 1-based line it happened on.
+         */
+        [[noreturn]] inline void throw_load_error(const char* begin, const char* at) {
+            size_t line = count_byte(begin, at, '\n') + 1;
+            throw std::invalid_argument("Invalid or missing value at line " + std::to_string(line));
+        }
+
+        /**
+         * @brief Parses a whole text buffer into a vector of values.
+         *
+         * Large inputs are split into one chunk per pool thread (plus the
+         * caller's), each starting after a newline, parsed concurrently into
+         * exactly pre-sized vectors and then concatenated in order.
+         * @param text The input.
+         * @param options Column, delimiter, header and threading.
+         * @return The values in input order.
+         * @throw std::invalid_argument If a field is not a valid value or a line lacks the column.
+         */
+        template<typename T>
+        std::vector<T> load_values(std::string_view text, const LoadOptions& options) {
+            // An empty file maps to no memory at all: data() may be null.
+            if (text.empty()) {
+                return std::vector<T>();
+            }
+            const char* begin = text.data();
+            const char* first = begin;
+            const char* last = begin + text.size();
+            if (options.header) {
+                const char* newline = static_cast<const char*>(std::memchr(first, '\n', text.size()));
+                first = newline ? newline + 1 : last;
+            }
+
+            ThreadPool* pool = !options.parallel ? nullptr : options.pool ? options.pool : default_parallel_pool();
+            size_t bytes = static_cast<size_t>(last - first);
+            size_t chunks = pool ? std::min(pool->size() + 1, std::max<size_t>(bytes / load_chunk_bytes, 1)) : 1;
+
+            std::vector<T> values;
+            if (chunks == 1) {
+                values.reserve(count_values(first, last, options));
+                if (const char* error = parse_lines(first, last, options, values)) {
+                    throw_load_error(begin, error);
+                }
+                return values;
+            }
+
+            // Chunk c covers [bounds[c], bounds[c + 1]); every bound but the ends follows a newline.
+            std::vector<const char*> bounds(chunks + 1, last);
+            bounds[0] = first;
+            for (size_t c = 1; c < chunks; ++c) {
+                const char* guess = std::max(first + bytes * c / chunks, bounds[c - 1]);
+                const char* newline = static_cast<const char*>(std::memchr(guess, '\n', static_cast<size_t>(last - guess)));
+                bounds[c] = newline ? newline + 1 : last;
+            }
+            std::vector<std::vector<T>> parts(chunks);
+            std::vector<const char*> errors(chunks, nullptr);
+            pool->run_chunks(chunks, [&](size_t c) {
+                parts[c].reserve(count_values(bounds[c], bounds[c + 1], options));
+                errors[c] = parse_lines(bounds[c], bounds[c + 1], options, parts[c]);
+            });
+            for (const char* error : errors) {
+                if (error) {
+                    throw_load_error(begin, error);
+                }
+            }
+            size_t total = 0;
+            for (const auto& part : parts) {
+                total += part.size();
+            }
+            values.reserve(total);
+            for (auto& part : parts) {
+                values.insert(values.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+            }
+            return values;
+        }
+
+        /**
+         * @brief Read-only view of a whole file: memory-mapped where available, read into memory otherwise.
+         */
+        class MappedFile {
+        private:
+            const char* data = nullptr;
+            size_t length = 0;
+            std::string fallback;
+#ifdef MYCONTAINER_HAS_MMAP
+            void* mapping = nullptr;
+#endif
+
+        public:
+            /**
+             * @brief Opens and maps a file.
+             * @param path Path of the file.
+             * @throw std::invalid_argument If the file cannot be opened or read.
+             */
+            explicit MappedFile(const std::string& path) {
+#ifdef MYCONTAINER_HAS_MMAP
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    throw std::invalid_argument("Cannot open file: " + path);
+                }
+                struct stat info;
+                if (::fstat(fd, &info) != 0) {
+                    ::close(fd);
+                    throw std::invalid_argument("Cannot read file: " + path);
+                }
+                length = static_cast<size_t>(info.st_size);
+                if (length != 0) {
+                    mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapping == MAP_FAILED) {
+                        mapping = nullptr;
+                        ::close(fd);
+                        throw std::invalid_argument("Cannot map file: " + path);
+                    }
+                    ::madvise(mapping, length, MADV_SEQUENTIAL);
+                    data = static_cast<const char*>(mapping);
+                }
+                ::close(fd);
+#else
+                std::ifstream file(path, std::ios::binary);
+                if (!file) {
+                    throw std::invalid_argument("Cannot open file: " + path);
+                }
+                fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                data = fallback.data();
+                length = fallback.size();
+#endif
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile() {
+#ifdef MYCONTAINER_HAS_MMAP
+                if (mapping) {
+                    ::munmap(mapping, length);
+                }
+#endif
+            }
+
+            /**
+             * @brief Returns the file's contents.
+             * @return View of the whole file.
+             */
+            std::string_view text() const {
+                return std::string_view(data, length);
+            }
+        };
+    }
+
+}
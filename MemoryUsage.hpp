@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Bytes held by a container and its order iterators, see MyContainer::memory_usage().
+     *
+     * A buffer shared copy-on-write with other containers is counted in
+     * full by each of them.
+     */
+    struct MemoryUsage {
+        size_t element_bytes = 0;
+        size_t capacity_slack_bytes = 0;
+        size_t element_heap_bytes = 0;
+        size_t cached_permutation_bytes = 0;
+        size_t live_index_bytes = 0;
+        size_t peak_index_bytes = 0;
+        size_t filter_bytes = 0;
+
+        /**
+         * @brief Everything currently held: elements, slack, element payloads,
+         * live index buffers (cached or held by iterators) and the filter.
+         * @return The total in bytes.
+         */
+        size_t total() const {
+            return element_bytes + capacity_slack_bytes + element_heap_bytes + live_index_bytes + filter_bytes;
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Heap bytes owned by an element beyond sizeof(T); zero unless T is string-like.
+         */
+        template<typename T, typename = void>
+        struct heap_payload {
+            static size_t bytes(const T&) {
+                return 0;
+            }
+        };
+
+        template<typename T>
+        struct heap_payload<T, std::void_t<decltype(std::declval<const T&>().c_str()),
+                                           decltype(std::declval<const T&>().capacity())>> {
+            static size_t bytes(const T& value) {
+                // Short strings live inside the object itself (small-string optimization).
+                const char* payload = reinterpret_cast<const char*>(value.c_str());
+                const char* object = reinterpret_cast<const char*>(&value);
+                if (payload >= object && payload < object + sizeof(T)) {
+                    return 0;
+                }
+                return (value.capacity() + 1) * sizeof(*value.c_str());
+            }
+        };
+
+        /**
+         * @brief Live and peak bytes of the index buffers built for one permutation cache.
+         *
+         * Buffers report themselves when they are freed, so a permutation
+         * still held by an iterator after the cache dropped it keeps counting.
+         */
+        class IndexMemory {
+        private:
+            std::atomic<size_t> live{0};
+            std::atomic<size_t> peak{0};
+
+        public:
+            void acquire(size_t bytes) {
+                size_t now = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                size_t high = peak.load(std::memory_order_relaxed);
+                while (now > high && !peak.compare_exchange_weak(high, now, std::memory_order_relaxed)) {
+                }
+            }
+
+            void release(size_t bytes) {
+                live.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            size_t live_bytes() const {
+                return live.load(std::memory_order_relaxed);
+            }
+
+            size_t peak_bytes() const {
+                return peak.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Restarts the high-water mark from the current live bytes.
+             */
+            void reset_peak() {
+                peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        };
+    }
+
+}
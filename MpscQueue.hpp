@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Bounded lock-free multi-producer / single-consumer ring buffer.
+     *
+     * Each cell carries a sequence number that tells producers whether it is
+     * free for the current lap and tells the consumer whether it is filled, so
+     * producers only contend on one fetch position (a CAS) and never block each
+     * other or the consumer. Any number of threads may push; only one thread at
+     * a time may pop or drain.
+     *
+     * @tparam T The element type.
+     */
+    template<typename T>
+    class MpscQueue {
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T& value() {
+                return *std::launder(reinterpret_cast<T*>(storage));
+            }
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        alignas(64) std::atomic<size_t> enqueue_pos{0};
+        alignas(64) size_t dequeue_pos = 0;
+
+    public:
+        /**
+         * @brief Constructor for the queue.
+         * @param capacity Maximum number of queued elements (rounded up to a power of two, at least 2).
+         * @throw std::invalid_argument If capacity is zero.
+         */
+        explicit MpscQueue(size_t capacity) {
+            if (capacity == 0) {
+                throw std::invalid_argument("Queue capacity must be positive");
+            }
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            cells.reset(new Cell[size]);
+            for (size_t i = 0; i < size; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            mask = size - 1;
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /**
+         * @brief Destructor. Destroys any elements still queued.
+         */
+        ~MpscQueue() {
+            drain([](T&&) {});
+        }
+
+        /**
+         * @brief Enqueues an element if there is room. Safe from any thread.
+         * @param element The element to enqueue.
+         * @return False if the queue is full.
+         */
+        bool try_push(const T& element) {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[pos & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (lap == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (lap < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            new (cell->storage) T(element);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Enqueues an element, yielding while the queue is full. Safe from any thread.
+         * @param element The element to enqueue.
+         */
+        void push(const T& element) {
+            while (!try_push(element)) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @brief Dequeues the oldest element. Consumer thread only.
+         * @param out Receives the element.
+         * @return False if the queue is empty.
+         */
+        bool try_pop(T& out) {
+            Cell& cell = cells[dequeue_pos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) {
+                return false;
+            }
+            out = std::move(cell.value());
+            cell.value().~T();
+            cell.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+            ++dequeue_pos;
+            return true;
+        }
+
+        /**
+         * @brief Dequeues up to max_count elements, handing each to f. Consumer thread only.
+         * @param f Callable taking T&& for each element, in FIFO order.
+         * @param max_count Maximum number of elements to dequeue.
+         * @return The number of elements dequeued.
+         */
+        template<typename F>
+        size_t drain(F&& f, size_t max_count = SIZE_MAX) {
+            size_t drained = 0;
+            while (drained < max_count) {
+                Cell& cell = cells[dequeue_pos & mask];
+                if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) {
+                    break;
+                }
+                f(std::move(cell.value()));
+                cell.value().~T();
+                cell.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+                ++dequeue_pos;
+                ++drained;
+            }
+            return drained;
+        }
+
+        /**
+         * @brief Returns the maximum number of queued elements.
+         * @return The capacity.
+         */
+        size_t capacity() const {
+            return mask + 1;
+        }
+
+        /**
+         * @brief Approximate number of queued elements (exact from the consumer when producers are idle).
+         * @return The number of elements.
+         */
+        size_t size_approx() const {
+            size_t pushed = enqueue_pos.load(std::memory_order_acquire);
+            return pushed > dequeue_pos ? pushed - dequeue_pos : 0;
+        }
+    };
+
+}
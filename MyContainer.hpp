@@ -4,12 +4,35 @@
 #include <stdexcept>
 #include <iostream>
 #include <type_traits>
+#include <functional>
+#include <optional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "OrderedIterator.hpp"
+#include "PermutationCache.hpp"
+#include "MemoryUsage.hpp"
+#include "Trace.hpp"
+#include "Format.hpp"
+#include "Loader.hpp"
+#include "CustomOrder.hpp"
+#include "IndexMap.hpp"
+#include "Span.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include "Parallel.hpp"
+#include "Reductions.hpp"
+#include "Search.hpp"
+#include "BloomFilter.hpp"
+#include "MpscQueue.hpp"
 #include "AscendingOrder.hpp"
 #include "DescendingOrder.hpp"
 #include "SideCrossOrder.hpp"
 #include "ReverseOrder.hpp"
 #include "Order.hpp"
 #include "MiddleOutOrder.hpp"
+#include "RandomOrder.hpp"
+#include "StreamingOrder.hpp"
 
 
 namespace MyContainerNamespace {
@@ -17,24 +40,267 @@ namespace MyContainerNamespace {
 template<typename T = int>
 class MyContainer {
 private:
-    std::vector<T> data;
+    /**
+     * @brief Optional Bloom filter answering "certainly absent" for remove/contains.
+     *
+     * Const readers may rebuild it lazily and bump its counters concurrently:
+     * rebuilds are serialized by lock and publish the generation and size
+     * they synced to with release order, after the bits, and the counters are
+     * relaxed atomics.
+     */
+    struct MembershipFilter {
+        // Never the size of real data, so the filter is rebuilt on its next use.
+        static constexpr size_t unsynced = SIZE_MAX;
+
+        BloomFilter bloom;
+        uint64_t (*hash)(const T&) = nullptr;
+        double false_positive_rate = 0.01;
+        size_t capacity = 0;
+        size_t removals_since_rebuild = 0;
+        // The data generation and size the filter was last brought up to date with.
+        std::atomic<uint64_t> synced_generation{0};
+        std::atomic<size_t> synced_size{unsynced};
+        std::atomic<size_t> queries{0};
+        std::atomic<size_t> rejected{0};
+        std::atomic<size_t> false_positives{0};
+        std::atomic<size_t> rebuilds{0};
+        mutable std::mutex lock;
+
+        MembershipFilter() = default;
+        MembershipFilter(const MembershipFilter& other) {
+            *this = other;
+        }
+        MembershipFilter& operator=(const MembershipFilter& other) {
+            if (this == &other) {
+                return *this;
+            }
+            std::lock_guard<std::mutex> guard(other.lock);
+            bloom = other.bloom;
+            hash = other.hash;
+            false_positive_rate = other.false_positive_rate;
+            capacity = other.capacity;
+            removals_since_rebuild = other.removals_since_rebuild;
+            synced_generation.store(other.synced_generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            synced_size.store(other.synced_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            queries.store(other.queries.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            rejected.store(other.rejected.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            false_positives.store(other.false_positives.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            rebuilds.store(other.rebuilds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    // Copies share one buffer and its permutation cache until one of them writes.
+    std::shared_ptr<std::vector<T>> storage = std::make_shared<std::vector<T>>();
+    std::shared_ptr<PermutationCache> permutation_cache = std::make_shared<PermutationCache>();
+    // Bumped whenever a mutable reference into the buffer is handed out; the
+    // cache and the filter discard what they derived in an earlier generation.
+    uint64_t generation = 0;
+    // Set once a mutable reference has been handed out. A reference may still
+    // write, so the buffer is never shared with copies from then on.
+    bool exposed = false;
+    mutable std::optional<MembershipFilter> membership_filter;
+
+    /**
+     * @brief Read access to the elements.
+     */
+    const std::vector<T>& values() const {
+        return *storage;
+    }
+
+    /**
+     * @brief Write access to the elements; first detaches from copies sharing the buffer.
+     */
+    std::vector<T>& writable() {
+        if (storage.use_count() > 1) {
+            MYCONTAINER_TRACE_SPAN("copy-on-write detach", storage->size());
+            storage = std::make_shared<std::vector<T>>(*storage);
+            permutation_cache = permutation_cache->detached();
+        } else {
+            // Pairs with the release decrement of a copy released on another thread.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *storage;
+    }
+
+    /**
+     * @brief Invalidates derived state after any (possible) mutation of data.
+     */
+    void on_mutation() {
+        permutation_cache->clear();
+    }
+
+    /**
+     * @brief Starts a new data generation before handing out a mutable reference.
+     * Cached orders and the filter are revalidated lazily, on their next use.
+     */
+    void on_external_mutation() {
+        writable();
+        exposed = true;
+        ++generation;
+    }
+
+    /**
+     * @brief Whether the membership filter reflects the current data.
+     * @param size The size the data must have had when the filter was synced.
+     */
+    bool filter_current(size_t size) const {
+        const MembershipFilter& filter = *membership_filter;
+        return filter.synced_size.load(std::memory_order_acquire) == size &&
+               filter.synced_generation.load(std::memory_order_acquire) == generation;
+    }
+
+    /**
+     * @brief Rebuilds the membership filter if it does not reflect the current
+     * data. Safe to call from concurrent const readers.
+     */
+    void sync_filter() const {
+        if (filter_current(values().size())) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(membership_filter->lock);
+        if (!filter_current(values().size())) {
+            rebuild_filter();
+        }
+    }
+
+    /**
+     * @brief Rebuilds the membership filter from the current data, sized for twice its size.
+     * Caller holds the filter's lock or has exclusive access to the container.
+     */
+    void rebuild_filter() const {
+        MembershipFilter& filter = *membership_filter;
+        const std::vector<T>& data = values();
+        MYCONTAINER_TRACE_SPAN("membership filter rebuild", data.size());
+        filter.capacity = std::max<size_t>(2 * data.size(), 1024);
+        filter.bloom = BloomFilter(filter.capacity, filter.false_positive_rate);
+        for (const T& element : data) {
+            filter.bloom.insert(filter.hash(element));
+        }
+        filter.removals_since_rebuild = 0;
+        filter.rebuilds.fetch_add(1, std::memory_order_relaxed);
+        filter.synced_generation.store(generation, std::memory_order_release);
+        filter.synced_size.store(data.size(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Brings derived state up to date after appending data[first..size()).
+     * @param first Index of the first appended element.
+     */
+    void on_append(size_t first) {
+        if (membership_filter && filter_current(first)) {
+            const std::vector<T>& data = values();
+            if (data.size() > membership_filter->capacity) {
+                rebuild_filter();
+            } else {
+                for (size_t i = first; i < data.size(); ++i) {
+                    membership_filter->bloom.insert(membership_filter->hash(data[i]));
+                }
+                membership_filter->synced_size.store(data.size(), std::memory_order_relaxed);
+            }
+        }
+        on_mutation();
+    }
+
+    /**
+     * @brief Consults the membership filter, if enabled.
+     * @param element The element looked up.
+     * @return False only if the element is certainly absent.
+     */
+    bool filter_may_contain(const T& element) const {
+        if (!membership_filter) {
+            return true;
+        }
+        sync_filter();
+        membership_filter->queries.fetch_add(1, std::memory_order_relaxed);
+        if (!membership_filter->bloom.may_contain(membership_filter->hash(element))) {
+            membership_filter->rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Calls f with the position-to-index map of an order.
+     * @param policy The mapping policy of the order.
+     * @param f Callable taking a detail::ClosedFormMap or detail::PermutationMap.
+     */
+    template<typename Policy, typename F>
+    void with_index_map(const Policy& policy, F&& f) const {
+        if constexpr (detail::has_index_at<Policy>::value) {
+            f(detail::ClosedFormMap<Policy>{policy, values().size()});
+        } else {
+            auto permutation = permutation_for(policy);
+            f(detail::PermutationMap{permutation->data(), permutation->size()});
+        }
+    }
 
 public:
     // Default constructor
     MyContainer() = default;
     /**
-     * @brief Copy constructor. Creates a copy of another container.
+     * @brief Constructs a container that takes over an existing vector of elements.
+     * @param elements The elements, in insertion order.
+     */
+    explicit MyContainer(std::vector<T> elements)
+        : storage(std::make_shared<std::vector<T>>(std::move(elements))) {}
+    /**
+     * @brief Builds a container from text: one value per line (column
+     * options.column of delimiter-separated fields), or every field with
+     * LoadOptions::all_fields. Numbers are parsed with std::from_chars, and
+     * large inputs are split across threads at line boundaries.
+     * @param text The input, e.g. CSV.
+     * @param options Column, delimiter, header line and threading.
+     * @return The container, in input order.
+     * @throw std::invalid_argument If a field is not a valid T or a line lacks the column.
+     */
+    static MyContainer from_text(std::string_view text, const LoadOptions& options = LoadOptions()) {
+        MYCONTAINER_TRACE_SPAN("load", text.size());
+        return MyContainer(detail::load_values<T>(text, options));
+    }
+    /**
+     * @brief Builds a container from a file, memory-mapped and parsed like from_text().
+     * @param path Path of the file.
+     * @param options Column, delimiter, header line and threading.
+     * @return The container, in file order.
+     * @throw std::invalid_argument If the file cannot be read or its contents cannot be parsed.
+     */
+    static MyContainer from_file(const std::string& path, const LoadOptions& options = LoadOptions()) {
+        detail::MappedFile file(path);
+        return from_text(file.text(), options);
+    }
+    /**
+     * @brief Copy constructor. The copy shares the buffer (and cached orders)
+     * with other, and the buffer is duplicated on the first write to either;
+     * a container whose buffer was handed out through getData() or
+     * operator[] is deep-copied instead.
      * @param other The container to copy from.
      */
-    MyContainer(const MyContainer& other) : data(other.data) {}
+    MyContainer(const MyContainer& other)
+        : storage(other.exposed ? std::make_shared<std::vector<T>>(other.values()) : other.storage),
+          permutation_cache(other.exposed ? other.permutation_cache->detached() : other.permutation_cache),
+          generation(other.generation),
+          membership_filter(other.membership_filter) {
+        if (other.exposed && membership_filter) {
+            membership_filter->synced_size.store(MembershipFilter::unsynced, std::memory_order_relaxed);
+        }
+    }
     /**
-     * @brief Assignment operator. Assigns the contents of another container.
+     * @brief Assignment operator. Assigns the contents of another container,
+     * sharing its buffer like the copy constructor.
      * @param other The container to assign from.
      * @return Reference to this container.
      */
     MyContainer& operator=(const MyContainer& other) {
         if (this != &other) {
-            data = other.data;
+            storage = other.exposed ? std::make_shared<std::vector<T>>(other.values()) : other.storage;
+            permutation_cache = other.exposed ? other.permutation_cache->detached() : other.permutation_cache;
+            generation = other.generation;
+            exposed = false;
+            membership_filter = other.membership_filter;
+            if (other.exposed && membership_filter) {
+                membership_filter->synced_size.store(MembershipFilter::unsynced, std::memory_order_relaxed);
+            }
         }
         return *this;
     }
@@ -48,7 +314,50 @@ public:
      * @param element The element to add.
      */
     void add(const T& element) {
-        data.push_back(element);
+        std::vector<T>& data = writable();
+        {
+            MYCONTAINER_TRACE_SPAN_IF(data.size() == data.capacity(), "vector realloc", data.size());
+            data.push_back(element);
+        }
+        on_append(data.size() - 1);
+    }
+    /**
+     * @brief Adds a range of elements, invalidating derived state once for the whole batch.
+     * @param first Iterator to the first element to add.
+     * @param last Iterator past the last element to add.
+     */
+    template<typename InputIt>
+    void add_range(InputIt first, InputIt last) {
+        std::vector<T>& data = writable();
+        size_t old_size = data.size();
+        {
+            MYCONTAINER_TRACE_SPAN("add_range", old_size);
+            data.insert(data.end(), first, last);
+        }
+        on_append(old_size);
+    }
+    /**
+     * @brief Moves up to max_batch queued elements into the container, in FIFO order.
+     * Must be called from the queue's single consumer thread. Derived state is
+     * invalidated once per call rather than once per element.
+     * @param queue The queue to drain.
+     * @param max_batch Maximum number of elements to take.
+     * @return The number of elements added.
+     */
+    size_t drain(MpscQueue<T>& queue, size_t max_batch = SIZE_MAX) {
+        std::vector<T>& data = writable();
+        size_t old_size = data.size();
+        // One allocation for the whole batch, but still growing geometrically across drains.
+        size_t wanted = old_size + std::min(max_batch, queue.size_approx());
+        if (wanted > data.capacity()) {
+            data.reserve(std::max(wanted, 2 * data.capacity()));
+        }
+        MYCONTAINER_TRACE_SPAN("queue drain", old_size);
+        size_t drained = queue.drain([&data](T&& element) { data.push_back(std::move(element)); }, max_batch);
+        if (drained != 0) {
+            on_append(old_size);
+        }
+        return drained;
     }
     /**
      * @brief Removes an element from the container.
@@ -56,26 +365,118 @@ public:
      * @throw std::invalid_argument If the element is not found in the container.
      */
     void remove(const T& element) {
-        auto it = std::find(data.begin(), data.end(), element);
-        if (it == data.end()) {
+        if (!filter_may_contain(element)) {
+            throw std::invalid_argument("Element not found in container");
+        }
+        size_t first = detail::find_equal(values().data(), values().size(), element);
+        if (first == values().size()) {
+            if (membership_filter) {
+                membership_filter->false_positives.fetch_add(1, std::memory_order_relaxed);
+            }
             throw std::invalid_argument("Element not found in container");
         }
-        
-        data.erase(std::remove(data.begin(), data.end(), element), data.end());
+
+        std::vector<T>& data = writable();
+        {
+            MYCONTAINER_TRACE_SPAN("remove compaction", data.size());
+            size_t kept = first + detail::remove_equal(data.data() + first, data.size() - first, element);
+            data.erase(data.begin() + kept, data.end());
+        }
+        if (membership_filter) {
+            // The filter was synced above; what it still holds for removed elements only costs false positives.
+            membership_filter->synced_size.store(data.size(), std::memory_order_relaxed);
+            if (++membership_filter->removals_since_rebuild > membership_filter->capacity / 4) {
+                rebuild_filter();
+            }
+        }
+        on_mutation();
+    }
+
+    /**
+     * @brief Checks whether the container holds an element.
+     * @param element The element to look for.
+     * @return True if an equal element is present.
+     */
+    bool contains(const T& element) const {
+        if (!filter_may_contain(element)) {
+            return false;
+        }
+        bool found = detail::find_equal(values().data(), values().size(), element) != values().size();
+        if (!found && membership_filter) {
+            membership_filter->false_positives.fetch_add(1, std::memory_order_relaxed);
+        }
+        return found;
+    }
+
+    /**
+     * @brief Enables a Bloom filter so that remove() and contains() reject
+     * absent elements without scanning the data.
+     *
+     * The filter is maintained by add(), rebuilt (at twice the current size)
+     * when it outgrows its capacity or after removals of a quarter of it.
+     * Non-const getData()/operator[] start a new data generation, and the
+     * filter is rebuilt on its next use in a new generation or when the size
+     * changed behind its back; a copy of such a container rebuilds it from
+     * the copied data.
+     * @tparam Hash Hash functor for T.
+     * @param false_positive_rate Target false-positive rate at capacity.
+     * @throw std::invalid_argument If the rate is not in (0, 1).
+     */
+    template<typename Hash = std::hash<T>>
+    void enable_membership_filter(double false_positive_rate = 0.01) {
+        if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+            throw std::invalid_argument("False-positive rate must be in (0, 1)");
+        }
+        membership_filter.emplace();
+        membership_filter->hash = [](const T& element) { return static_cast<uint64_t>(Hash()(element)); };
+        membership_filter->false_positive_rate = false_positive_rate;
+        rebuild_filter();
+    }
+
+    /**
+     * @brief Disables and frees the membership filter.
+     */
+    void disable_membership_filter() {
+        membership_filter.reset();
+    }
+
+    /**
+     * @brief Reports the membership filter's memory, false-positive rate and counters.
+     * @return The statistics (enabled == false if no filter is active).
+     */
+    MembershipFilterStats filter_stats() const {
+        MembershipFilterStats stats;
+        if (!membership_filter) {
+            return stats;
+        }
+        sync_filter();
+        const MembershipFilter& filter = *membership_filter;
+        stats.enabled = true;
+        stats.memory_bytes = filter.bloom.memory_bytes();
+        stats.bits = filter.bloom.bit_count();
+        stats.hash_functions = filter.bloom.hash_count();
+        stats.capacity = filter.capacity;
+        stats.target_false_positive_rate = filter.false_positive_rate;
+        stats.estimated_false_positive_rate = filter.bloom.estimated_false_positive_rate();
+        stats.queries = filter.queries.load(std::memory_order_relaxed);
+        stats.rejected = filter.rejected.load(std::memory_order_relaxed);
+        stats.false_positives = filter.false_positives.load(std::memory_order_relaxed);
+        stats.rebuilds = filter.rebuilds.load(std::memory_order_relaxed);
+        return stats;
     }
      /**
      * @brief Returns the number of elements in the container.
      * @return The size of the container.
      */   
     size_t size() const {
-        return data.size();
+        return values().size();
     }
     /**
      * @brief Checks if the container is empty.
      * @return True if the container is empty, false otherwise.
      */
     bool empty() const {
-        return data.empty();
+        return values().empty();
     }
 
     /**
@@ -85,34 +486,49 @@ public:
      * @throw std::out_of_range If the index is out of range.
      */
     const T& operator[](size_t index) const {
-        if (index >= data.size()) {
+        if (index >= values().size()) {
             throw std::out_of_range("Index out of range");
         }
-        return data[index];
+        return values()[index];
     }
     /**
      * @brief Accesses an element by index.
+     * Like getData(), detaches the buffer from copies sharing it and starts a
+     * new data generation, so a write through the reference is seen by the
+     * next traversal or lookup. Cached orders are kept until then and are
+     * rebuilt only if they are used after a non-const access.
      * @param index The index of the element.
      * @return Reference to the element.
      * @throw std::out_of_range If the index is out of range.
      */
     T& operator[](size_t index) {
-        if (index >= data.size()) {
+        if (index >= values().size()) {
             throw std::out_of_range("Index out of range");
         }
-        return data[index];
+        on_external_mutation();
+        return (*storage)[index];
     }
     /**
      * @brief Prints the container to an output stream.
+     * Integers and floating-point numbers on a stream with default formatting
+     * are formatted with std::to_chars into a local buffer and written in
+     * large blocks; the output is the same as inserting them one by one.
      * @param os The output stream.
      * @param container The container to print.
      * @return Reference to the output stream.
      */
     friend std::ostream& operator<<(std::ostream& os, const MyContainer& container) {
+        const std::vector<T>& data = container.values();
+        if constexpr (detail::to_chars_formattable<T>) {
+            if (detail::default_number_formatting(os)) {
+                detail::write_number_list(os, data.data(), data.size());
+                return os;
+            }
+        }
         os << "[";
-        for (size_t i = 0; i < container.data.size(); ++i) {
-            os << container.data[i];
-            if (i < container.data.size() - 1) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            os << data[i];
+            if (i < data.size() - 1) {
                 os << ", ";
             }
         }
@@ -124,21 +540,360 @@ public:
      * @return Const reference to the data vector.
      */
     const std::vector<T>& getData() const {
-        return data;
+        return values();
     }
     /**
      * @brief Returns a reference to the internal data vector.
+     * Starts a new data generation: cached permutations and the membership
+     * filter are rebuilt on their next use, so writes made before that use
+     * are seen. Writes through a reference kept across a traversal are seen
+     * by the next one only if they change the size; call getData() again
+     * after writing in place. The buffer is detached from any copies and is
+     * deep-copied by later copies.
      * @return Reference to the data vector.
      */
     std::vector<T>& getData() {
-        return data;
+        on_external_mutation();
+        return *storage;
+    }
+
+    /**
+     * @brief Visits a contiguous order (insertion or reverse) in blocks of the underlying storage.
+     *
+     * Each block is a view straight into the data, so consumers can run
+     * vectorized loops over it. For ReverseMapping the blocks come from the
+     * back of the data, and each block must be read back to front
+     * (block.rbegin()) to follow the traversal order exactly.
+     * @param policy InsertionMapping() or ReverseMapping().
+     * @param block_size Maximum number of elements per block.
+     * @param f Callable invoked with a Span<const T> per block.
+     * @throw std::invalid_argument If block_size is zero.
+     */
+    template<typename Policy, typename F>
+    void for_each_block(Policy /*policy*/, size_t block_size, F f) const {
+        constexpr int direction = detail::contiguous_direction<Policy>::value;
+        static_assert(direction != 0, "for_each_block needs a contiguous order; use for_each_gathered_block");
+        if (block_size == 0) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        size_t n = values().size();
+        size_t length = 0;
+        for (size_t done = 0; done < n; done += length) {
+            length = std::min(block_size, n - done);
+            const T* first = (direction > 0) ? values().data() + done : values().data() + (n - done - length);
+            f(Span<const T>(first, length));
+        }
+    }
+
+    /**
+     * @brief Visits any order in blocks gathered into a caller-provided buffer.
+     *
+     * Elements are copied into buffer in traversal order, block_size at a
+     * time, and f receives a view of the filled part of the buffer.
+     * @param policy The mapping policy of the order.
+     * @param buffer Scratch space with room for block_size elements.
+     * @param block_size Maximum number of elements per block.
+     * @param f Callable invoked with a Span<const T> per block.
+     * @throw std::invalid_argument If block_size is zero.
+     */
+    template<typename Policy, typename F>
+    void for_each_gathered_block(const Policy& policy, T* buffer, size_t block_size, F f) const {
+        if (block_size == 0) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        with_index_map(policy, [&](const auto& map) {
+            size_t n = values().size();
+            size_t length = 0;
+            for (size_t done = 0; done < n; done += length) {
+                length = std::min(block_size, n - done);
+                detail::gather(values().data(), map, done, length, buffer);
+                f(Span<const T>(buffer, length));
+            }
+        });
+    }
+
+    /**
+     * @brief Writes the container's elements, in the given order, into a preallocated buffer.
+     *
+     * Contiguous orders are plain copies. Permutations of 4- and 8-byte
+     * arithmetic types use AVX2/AVX-512 gathers when the CPU supports them,
+     * and containers above detail::parallel_threshold are split across threads.
+     * @param policy The mapping policy of the order.
+     * @param out Destination with room for size() elements.
+     */
+    template<typename Policy>
+    void materialize(const Policy& policy, T* out) const {
+        constexpr int direction = detail::contiguous_direction<Policy>::value;
+        const T* source = values().data();
+        if constexpr (direction > 0) {
+            detail::parallel_chunks(values().size(), detail::parallel_threshold, [&](size_t begin, size_t end) {
+                std::copy(source + begin, source + end, out + begin);
+            });
+        } else if constexpr (direction < 0) {
+            size_t n = values().size();
+            detail::parallel_chunks(n, detail::parallel_threshold, [&](size_t begin, size_t end) {
+                std::reverse_copy(source + (n - end), source + (n - begin), out + begin);
+            });
+        } else {
+            with_index_map(policy, [&](const auto& map) {
+                detail::parallel_chunks(values().size(), detail::parallel_threshold, [&](size_t begin, size_t end) {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(map)>, detail::PermutationMap>) {
+                        if (detail::simd_gather(source, map.indices + begin, end - begin, out + begin)) {
+                            return;
+                        }
+                    }
+                    detail::gather(source, map, begin, end - begin, out + begin);
+                });
+            });
+        }
+    }
+
+    /**
+     * @brief Returns a copy of the container's elements in the given order.
+     * @param policy The mapping policy of the order.
+     * @return Vector holding the elements in traversal order.
+     */
+    template<typename Policy>
+    std::vector<T> to_vector(const Policy& policy) const {
+        std::vector<T> result;
+        if constexpr (std::is_default_constructible_v<T>) {
+            result.resize(values().size());
+            materialize(policy, result.data());
+        } else {
+            result.reserve(values().size());
+            with_index_map(policy, [&](const auto& map) {
+                for (size_t k = 0; k < values().size(); ++k) {
+                    result.push_back(values()[map(k)]);
+                }
+            });
+        }
+        return result;
+    }
+
+    /**
+     * @brief Calls f on every element of an order, split across threads by position.
+     *
+     * Positions are cut into chunks of detail::parallel_grain, independent
+     * of the thread count; within a chunk f sees the elements in traversal
+     * order, but chunks run concurrently, so f must be thread-safe. Runs on
+     * the calling thread on single-core machines.
+     * @param policy The mapping policy of the order.
+     * @param f Callable taking const T&.
+     */
+    template<typename Policy, typename F>
+    void parallel_for_each(const Policy& policy, F f) const {
+        parallel_for_each(policy, f, detail::default_parallel_pool());
+    }
+
+    /**
+     * @brief parallel_for_each on a specific pool (nullptr: serially, in traversal order).
+     * @param policy The mapping policy of the order.
+     * @param f Callable taking const T&.
+     * @param pool The pool to run on.
+     */
+    template<typename Policy, typename F>
+    void parallel_for_each(const Policy& policy, F f, ThreadPool* pool) const {
+        const T* source = values().data();
+        with_index_map(policy, [&](const auto& map) {
+            detail::for_each_chunk(pool, values().size(), detail::parallel_grain, [&](size_t begin, size_t end) {
+                detail::visit(source, map, begin, end - begin, [&](size_t, const T& element) { f(element); });
+            });
+        });
+    }
+
+    /**
+     * @brief Writes f(element) for every element of an order, split across threads by position.
+     *
+     * out[k] receives f applied to the k-th element of the traversal, so the
+     * result does not depend on the number of threads.
+     * @param policy The mapping policy of the order.
+     * @param out Destination with room for size() results.
+     * @param f Thread-safe callable taking const T&.
+     */
+    template<typename Policy, typename U, typename F>
+    void parallel_transform(const Policy& policy, U* out, F f) const {
+        parallel_transform(policy, out, f, detail::default_parallel_pool());
+    }
+
+    /**
+     * @brief parallel_transform on a specific pool (nullptr: serially).
+     * @param policy The mapping policy of the order.
+     * @param out Destination with room for size() results.
+     * @param f Thread-safe callable taking const T&.
+     * @param pool The pool to run on.
+     */
+    template<typename Policy, typename U, typename F>
+    void parallel_transform(const Policy& policy, U* out, F f, ThreadPool* pool) const {
+        const T* source = values().data();
+        with_index_map(policy, [&](const auto& map) {
+            detail::for_each_chunk(pool, values().size(), detail::parallel_grain, [&](size_t begin, size_t end) {
+                detail::visit(source, map, begin, end - begin, [&](size_t k, const T& element) { out[k] = f(element); });
+            });
+        });
+    }
+
+    /**
+     * @brief Sums the elements (arithmetic T only).
+     * Integers are summed exactly in 64 bits, floating point in double.
+     * @param mode Fast or deterministic floating-point summation.
+     * @return The sum (0 for an empty container).
+     */
+    detail::sum_type<T> sum(Summation mode = Summation::Fast) const {
+        static_assert(std::is_arithmetic_v<T>, "sum() requires an arithmetic element type");
+        return detail::sum(values().data(), values().size(), mode);
+    }
+
+    /**
+     * @brief Returns the arithmetic mean of the elements (arithmetic T only).
+     * @param mode Fast or deterministic floating-point summation.
+     * @return The mean.
+     * @throw std::out_of_range If the container is empty.
+     */
+    double mean(Summation mode = Summation::Fast) const {
+        if (values().empty()) {
+            throw std::out_of_range("Container is empty");
+        }
+        return static_cast<double>(sum(mode)) / static_cast<double>(values().size());
+    }
+
+    /**
+     * @brief Returns the smallest and largest elements in a single pass.
+     * For floating point a NaN is propagated: if any element is NaN, both
+     * results are NaN, on every instruction set and thread count.
+     * @return Pair of (minimum, maximum).
+     * @throw std::out_of_range If the container is empty.
+     */
+    std::pair<T, T> minmax() const {
+        if (values().empty()) {
+            throw std::out_of_range("Container is empty");
+        }
+        return detail::minmax(values().data(), values().size());
+    }
+
+    /**
+     * @brief Returns the smallest element (NaN if any element is NaN).
+     * @return The minimum.
+     * @throw std::out_of_range If the container is empty.
+     */
+    T min() const {
+        return minmax().first;
+    }
+
+    /**
+     * @brief Returns the largest element (NaN if any element is NaN).
+     * @return The maximum.
+     * @throw std::out_of_range If the container is empty.
+     */
+    T max() const {
+        return minmax().second;
+    }
+
+    /**
+     * @brief Counts the elements equal to a value.
+     * @param value The value to count.
+     * @return The number of matching elements.
+     */
+    size_t count(const T& value) const {
+        return detail::count(values().data(), values().size(), value);
+    }
+
+    /**
+     * @brief Returns the permutation a permutation policy maps positions through.
+     * Stateless policies are built once and cached until the next mutation
+     * or the first use after a non-const getData()/operator[]; a cached
+     * permutation whose size no longer matches the data is rebuilt.
+     * @param policy The permutation policy.
+     * @return Shared, immutable permutation of data indices.
+     * @throw std::invalid_argument If the policy builds the wrong number of indices.
+     */
+    template<typename Policy>
+    std::shared_ptr<const std::vector<size_t>> permutation_for(const Policy& policy) const {
+        return permutation_cache->get_or_build(policy, values(), generation);
+    }
+
+    /**
+     * @brief Reports the memory held by the container and its order iterators.
+     *
+     * Index buffers are counted from the moment a permutation is built until
+     * its last holder lets go, so a permutation kept alive only by an
+     * outstanding iterator (after a mutation cleared the cache, or for an
+     * uncached custom order) still counts in live_index_bytes. For
+     * string-like elements the heap payload is summed in O(n).
+     * @return The breakdown in bytes.
+     */
+    MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        const std::vector<T>& data = values();
+        usage.element_bytes = data.size() * sizeof(T);
+        usage.capacity_slack_bytes = (data.capacity() - data.size()) * sizeof(T);
+        for (const T& element : data) {
+            usage.element_heap_bytes += detail::heap_payload<T>::bytes(element);
+        }
+        usage.cached_permutation_bytes = permutation_cache->cached_bytes();
+        usage.live_index_bytes = permutation_cache->live_index_bytes();
+        usage.peak_index_bytes = permutation_cache->peak_index_bytes();
+        if (membership_filter) {
+            std::lock_guard<std::mutex> guard(membership_filter->lock);
+            usage.filter_bytes = membership_filter->bloom.memory_bytes();
+        }
+        return usage;
+    }
+
+    /**
+     * @brief Restarts peak_index_bytes of memory_usage() from the index bytes live now.
+     */
+    void reset_peak_memory() {
+        permutation_cache->reset_index_peak();
+    }
+
+    /**
+     * @brief Reports the comparisons, index moves, index-buffer bytes and time
+     * spent building order permutations (sorting for the ascending,
+     * descending and side-cross orders), separately from iterating over them.
+     *
+     * Collected only when MYCONTAINER_INSTRUMENT is defined before the
+     * first include; otherwise nothing is counted and enabled is false.
+     * Totals accumulate across builds (including background ones) until
+     * reset_stats(), and carry over to copies.
+     * @return The statistics.
+     */
+    InstrumentationStats stats() const {
+        return permutation_cache->stats();
+    }
+
+    /**
+     * @brief Zeroes the statistics reported by stats().
+     */
+    void reset_stats() {
+        permutation_cache->reset_stats();
+    }
+
+    /**
+     * @brief Starts building an order's permutation in the background.
+     *
+     * The build runs on the pool against the current buffer, shared
+     * copy-on-write, so the container stays usable meanwhile: begin_* calls
+     * for the order wait for the build (or take it over if it has not
+     * started), and mutating the container detaches it from the buffer being
+     * read. Closed-form orders need no permutation and get a ready future
+     * holding nullptr; stateful permutation orders are built but not cached.
+     * @param policy The mapping policy of the order.
+     * @param pool The pool to build on.
+     * @return Future for the permutation; it rethrows the builder's exception.
+     */
+    template<typename Policy>
+    PermutationFuture prepare_async(const Policy& policy, ThreadPool& pool = detail::default_pool()) const {
+        if constexpr (detail::has_index_at<Policy>::value) {
+            std::promise<std::shared_ptr<const std::vector<size_t>>> none;
+            none.set_value(nullptr);
+            return none.get_future().share();
+        } else {
+            // A buffer reachable through a handed-out reference may change under the build, so copy it.
+            std::shared_ptr<const std::vector<T>> source = exposed ? std::make_shared<const std::vector<T>>(values())
+                                                                   : std::shared_ptr<const std::vector<T>>(storage);
+            return permutation_cache->build_async(policy, std::move(source), pool, generation);
+        }
     }
-        friend class AscendingOrder<T>;
-        friend class DescendingOrder<T>;
-        friend class SideCrossOrder<T>;
-        friend class ReverseOrder<T>;
-        friend class Order<T>;
-        friend class MiddleOutOrder<T>;
 
         // Iterator accessors
         /**
@@ -146,7 +901,7 @@ public:
          * @return An iterator to the beginning of the container.
          */
         auto begin_ascending_order() const { 
-            return AscendingOrder<T>(*this, 0); 
+            return begin_custom_order(AscendingMapping()); 
         }
 
         /**
@@ -154,7 +909,35 @@ public:
          * @return An iterator to the end of the container.
          */
         auto end_ascending_order() const { 
-            return AscendingOrder<T>(*this, data.size()); 
+            return end_custom_order(AscendingMapping()); 
+        }
+
+        /**
+         * @brief Returns an ascending iterator that yields while the sort is still running.
+         *
+         * Sorting happens in buckets on the pool; the first element is ready
+         * after one partition pass and one small bucket sort instead of a full
+         * sort. The stream works on a copy-on-write snapshot of the data.
+         * @param pool The pool that sorts the later buckets.
+         * @return An iterator to the beginning of the stream.
+         */
+        StreamingAscendingOrder<T> begin_streaming_ascending_order(ThreadPool& pool = detail::default_pool()) const {
+            if (values().empty()) {
+                return end_streaming_ascending_order();
+            }
+            std::shared_ptr<const std::vector<T>> source = exposed ? std::make_shared<const std::vector<T>>(values())
+                                                                   : std::shared_ptr<const std::vector<T>>(storage);
+            auto stream = std::make_shared<detail::AscendingStream<T>>(std::move(source));
+            detail::AscendingStream<T>::start(stream, pool);
+            return StreamingAscendingOrder<T>(*this, 0, values().size(), std::move(stream));
+        }
+
+        /**
+         * @brief Returns the end of a streaming ascending traversal.
+         * @return An iterator to the end of the container.
+         */
+        StreamingAscendingOrder<T> end_streaming_ascending_order() const {
+            return StreamingAscendingOrder<T>(*this, values().size(), values().size());
         }
 
         /**
@@ -162,7 +945,7 @@ public:
          * @return An iterator to the beginning of the container.
          */
         auto begin_descending_order() const { 
-            return DescendingOrder<T>(*this, 0); 
+            return begin_custom_order(DescendingMapping()); 
         }
 
         /**
@@ -170,7 +953,7 @@ public:
          * @return An iterator to the end of the container.
          */
         auto end_descending_order() const { 
-            return DescendingOrder<T>(*this, data.size()); 
+            return end_custom_order(DescendingMapping()); 
         }
 
         /**
@@ -178,7 +961,7 @@ public:
          * @return An iterator for side-cross order traversal.
          */
         auto begin_side_cross_order() const { 
-            return SideCrossOrder<T>(*this, 0); 
+            return begin_custom_order(SideCrossMapping()); 
         }
 
         /**
@@ -186,7 +969,7 @@ public:
          * @return An iterator to the end of the container.
          */
         auto end_side_cross_order() const { 
-            return SideCrossOrder<T>(*this, data.size()); 
+            return end_custom_order(SideCrossMapping()); 
         }
 
         /**
@@ -194,7 +977,7 @@ public:
          * @return An iterator to the beginning of the container in reverse order.
          */
         auto begin_reverse_order() const { 
-            return ReverseOrder<T>(*this, 0); 
+            return begin_custom_order(ReverseMapping()); 
         }
 
         /**
@@ -202,7 +985,7 @@ public:
          * @return An iterator to the end of the container in reverse order.
          */
         auto end_reverse_order() const { 
-            return ReverseOrder<T>(*this, data.size()); 
+            return end_custom_order(ReverseMapping()); 
         }
 
         /**
@@ -210,7 +993,7 @@ public:
          * @return An iterator to the beginning of the container in insertion order.
          */
         auto begin_order() const { 
-            return Order<T>(*this, 0); 
+            return begin_custom_order(InsertionMapping()); 
         }
 
         /**
@@ -218,7 +1001,7 @@ public:
          * @return An iterator to the end of the container in insertion order.
          */
         auto end_order() const { 
-            return Order<T>(*this, data.size()); 
+            return end_custom_order(InsertionMapping()); 
         }
 
         /**
@@ -226,7 +1009,7 @@ public:
          * @return An iterator to the beginning of the container in middle-out order.
          */
         auto begin_middle_out_order() const { 
-            return MiddleOutOrder<T>(*this, 0); 
+            return begin_custom_order(MiddleOutMapping()); 
         }
 
         /**
@@ -234,7 +1017,50 @@ public:
          * @return An iterator to the end of the container in middle-out order.
          */
         auto end_middle_out_order() const { 
-            return MiddleOutOrder<T>(*this, data.size()); 
+            return end_custom_order(MiddleOutMapping()); 
+        }
+
+        /**
+         * @brief Returns an iterator to the beginning of the container in seeded pseudo-random order.
+         * Every element is visited exactly once; the same seed gives the same order.
+         * @param seed The seed selecting the permutation.
+         * @return An iterator to the beginning of the container in random order.
+         */
+        auto begin_random_order(uint64_t seed = 0) const {
+            return begin_custom_order(RandomMapping(seed));
+        }
+
+        /**
+         * @brief Returns an iterator to the end of the container in seeded pseudo-random order.
+         * @param seed The seed selecting the permutation.
+         * @return An iterator to the end of the container in random order.
+         */
+        auto end_random_order(uint64_t seed = 0) const {
+            return end_custom_order(RandomMapping(seed));
+        }
+
+        /**
+         * @brief Returns an iterator to the beginning of a user-defined order.
+         *
+         * The policy is either closed-form (index_at(k, n)) or a permutation
+         * policy (build(data, indices)); see make_index_order() and
+         * make_permutation_order().
+         * @param policy The mapping policy describing the order.
+         * @return An iterator to the beginning of the order.
+         */
+        template<typename Policy>
+        OrderedIterator<T, Policy> begin_custom_order(Policy policy = Policy()) const {
+            return OrderedIterator<T, Policy>(*this, 0, std::move(policy));
+        }
+
+        /**
+         * @brief Returns an iterator to the end of a user-defined order.
+         * @param policy The mapping policy describing the order.
+         * @return An iterator to the end of the order.
+         */
+        template<typename Policy>
+        OrderedIterator<T, Policy> end_custom_order(Policy policy = Policy()) const {
+            return OrderedIterator<T, Policy>(*this, values().size(), std::move(policy));
         }
 };
 
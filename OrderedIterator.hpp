@@ -0,0 +1,290 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include "IndexMap.hpp"
+
+namespace MyContainerNamespace {
+
+    template<typename T>
+    class MyContainer;
+
+    namespace detail {
+        /**
+         * @brief Detects mapping policies that provide a closed-form index_at(k, n).
+         *
+         * Policies without it are permutation policies and must provide
+         * build(data, indices) instead.
+         */
+        template<typename Policy, typename = void>
+        struct has_index_at : std::false_type {};
+
+        template<typename Policy>
+        struct has_index_at<Policy, std::void_t<decltype(
+            std::declval<const Policy&>().index_at(size_t{}, size_t{}))>> : std::true_type {};
+    }
+
+    /**
+     * @brief Random-access iterator shared by every traversal order.
+     *
+     * The order itself is described by MappingPolicy, which maps a traversal
+     * position k to an index into the container's data. A policy is either
+     * closed-form (index_at(k, n), no extra memory) or a permutation policy
+     * (build(data, indices), taken from the container's permutation cache).
+     * End iterators never build a permutation, so end_*() is O(1), and
+     * advancing a permutation-backed iterator prefetches the element
+     * MYCONTAINER_PREFETCH_DISTANCE positions ahead.
+     *
+     * @tparam T The element type.
+     * @tparam MappingPolicy The position-to-index mapping.
+     */
+    template<typename T, typename MappingPolicy>
+    class OrderedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        static constexpr bool closed_form = detail::has_index_at<MappingPolicy>::value;
+
+    private:
+        const MyContainer<T>* container = nullptr;
+        MappingPolicy policy;
+        mutable std::shared_ptr<const std::vector<size_t>> indices;
+        size_t current_index = 0;
+
+        /**
+         * @brief Maps a traversal position to an index into the data.
+         * @param pos The traversal position (must be < size()).
+         * @return The data index visited at that position.
+         */
+        size_t index_of(size_t pos) const {
+            if constexpr (closed_form) {
+                size_t index = policy.index_at(pos, container->size());
+                if (index >= container->size()) {
+                    throw std::out_of_range("Mapping produced index out of range");
+                }
+                return index;
+            } else {
+                // Elements added since the build (e.g. through getData()) are past its end: rebuild.
+                if (!indices || pos >= indices->size()) {
+                    indices = container->permutation_for(policy);
+                }
+                return (*indices)[pos];
+            }
+        }
+
+        void check_position(size_t pos) const {
+            if (pos > container->size()) {
+                throw std::out_of_range("Iterator moved out of range");
+            }
+        }
+
+    public:
+        /**
+         * @brief Singular iterator over no container, to be assigned before use.
+         * Value-initialized iterators compare equal. Available when the policy
+         * is default-constructible.
+         */
+        OrderedIterator() = default;
+
+        /**
+         * @brief Constructor for the iterator.
+         * @param cont Reference to the container.
+         * @param pos The starting position (default is 0).
+         * @param mapping The mapping policy instance (default constructed if omitted).
+         */
+        explicit OrderedIterator(const MyContainer<T>& cont, size_t pos = 0,
+                                 MappingPolicy mapping = MappingPolicy())
+            : container(&cont), policy(std::move(mapping)), current_index(pos) {
+            if constexpr (!closed_form) {
+                if (current_index < container->size()) {
+                    indices = container->permutation_for(policy);
+                }
+            }
+        }
+
+        /**
+         * @brief Access current element.
+         * @return Reference to the current element.
+         * @throw std::out_of_range If out of bounds
+         */
+        const T& operator*() const {
+            if (current_index >= container->size()) {
+                throw std::out_of_range("Iterator out of bounds");
+            }
+            return container->getData()[index_of(current_index)];
+        }
+
+        /**
+         * @brief Member access to the current element.
+         * @return Pointer to the current element.
+         * @throw std::out_of_range If out of bounds
+         */
+        const T* operator->() const {
+            return &**this;
+        }
+
+        /**
+         * @brief Access the element n positions away from the current one.
+         * @param n The offset from the current position.
+         * @return Reference to that element.
+         * @throw std::out_of_range If the target position is out of bounds
+         */
+        const T& operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        /**
+         * @brief Pre-increment operator. Advance to next position.
+         * @return Reference after increment.
+         * @throw std::out_of_range If incrementing past end
+         */
+        OrderedIterator& operator++() {
+            if (current_index >= container->size()) {
+                throw std::out_of_range("Cannot increment iterator past end");
+            }
+            ++current_index;
+            if constexpr (!closed_form && detail::prefetch_distance > 0) {
+                size_t ahead = current_index + detail::prefetch_distance;
+                if (indices && ahead < indices->size()) {
+                    detail::prefetch(&container->getData()[(*indices)[ahead]]);
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Post-increment operator. Advance to next position.
+         * @return Copy of the iterator before increment.
+         * @throw std::out_of_range If incrementing past end
+         */
+        OrderedIterator operator++(int) {
+            OrderedIterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        /**
+         * @brief Pre-decrement operator. Step back to previous position.
+         * @return Reference after decrement.
+         * @throw std::out_of_range If decrementing before the first position
+         */
+        OrderedIterator& operator--() {
+            if (current_index == 0) {
+                throw std::out_of_range("Cannot decrement iterator before begin");
+            }
+            --current_index;
+            return *this;
+        }
+
+        /**
+         * @brief Post-decrement operator. Step back to previous position.
+         * @return Copy of the iterator before decrement.
+         * @throw std::out_of_range If decrementing before the first position
+         */
+        OrderedIterator operator--(int) {
+            OrderedIterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        /**
+         * @brief Move the iterator by n positions.
+         * @param n The (possibly negative) offset.
+         * @return Reference after the move.
+         * @throw std::out_of_range If the result is outside [begin, end]
+         */
+        OrderedIterator& operator+=(difference_type n) {
+            if (n < 0 && static_cast<size_t>(-n) > current_index) {
+                throw std::out_of_range("Iterator moved out of range");
+            }
+            size_t target = current_index + static_cast<size_t>(n);
+            check_position(target);
+            current_index = target;
+            return *this;
+        }
+
+        /**
+         * @brief Move the iterator back by n positions.
+         * @param n The (possibly negative) offset.
+         * @return Reference after the move.
+         * @throw std::out_of_range If the result is outside [begin, end]
+         */
+        OrderedIterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        OrderedIterator operator+(difference_type n) const {
+            OrderedIterator temp = *this;
+            return temp += n;
+        }
+
+        friend OrderedIterator operator+(difference_type n, const OrderedIterator& it) {
+            return it + n;
+        }
+
+        OrderedIterator operator-(difference_type n) const {
+            OrderedIterator temp = *this;
+            return temp -= n;
+        }
+
+        /**
+         * @brief Distance between two iterators over the same container.
+         * @param other Another iterator.
+         * @return Number of positions from other to this.
+         */
+        difference_type operator-(const OrderedIterator& other) const {
+            return static_cast<difference_type>(current_index) -
+                   static_cast<difference_type>(other.current_index);
+        }
+
+        /**
+         * @brief Returns the traversal position of the iterator.
+         * @return The zero-based position within the order.
+         */
+        size_t position() const {
+            return current_index;
+        }
+
+        /**
+         * @brief Equality operator.
+         * @param other The other iterator to compare with.
+         * @return True if same position and container.
+         */
+        bool operator==(const OrderedIterator& other) const {
+            return current_index == other.current_index && container == other.container;
+        }
+
+        /**
+         * @brief Inequality operator.
+         * @param other The other iterator to compare with.
+         * @return True if different position or container.
+         */
+        bool operator!=(const OrderedIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const OrderedIterator& other) const {
+            return current_index < other.current_index;
+        }
+
+        bool operator>(const OrderedIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const OrderedIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const OrderedIterator& other) const {
+            return !(*this < other);
+        }
+    };
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ThreadPool.hpp"
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief Element count above which bulk operations split work across threads.
+         */
+        inline constexpr size_t parallel_threshold = size_t{1} << 20;
+
+        /**
+         * @brief Positions per chunk for the order-aware parallel algorithms.
+         * Fixed, so chunk boundaries do not depend on the machine.
+         */
+        inline constexpr size_t parallel_grain = size_t{1} << 14;
+
+        /**
+         * @brief Whether parallel splits are worth it on this machine.
+         */
+        inline bool parallel_hardware() {
+            return std::thread::hardware_concurrency() > 1;
+        }
+
+        /**
+         * @brief Runs f(begin, end) over [0, n), split into one contiguous chunk per
+         * hardware thread on the default pool when n reaches the threshold,
+         * inline otherwise.
+         *
+         * The first exception thrown by any chunk is rethrown to the caller
+         * once all chunks have finished.
+         * @param n Number of positions.
+         * @param threshold Minimum n for a parallel split.
+         * @param f Callable taking (size_t begin, size_t end).
+         */
+        template<typename F>
+        void parallel_chunks(size_t n, size_t threshold, F f) {
+            if (n < threshold || !parallel_hardware()) {
+                f(size_t{0}, n);
+                return;
+            }
+            ThreadPool& pool = default_pool();
+            size_t chunks = pool.size() + 1;
+            size_t chunk = (n + chunks - 1) / chunks;
+            pool.run_chunks((n + chunk - 1) / chunk, [&](size_t c) {
+                f(c * chunk, std::min(n, (c + 1) * chunk));
+            });
+        }
+
+        /**
+         * @brief Runs f(begin, end) over [0, n) in chunks of exactly grain positions
+         * (the last one shorter).
+         *
+         * Chunk boundaries depend only on n and grain. With a pool, chunks run
+         * concurrently in no particular order; without one (nullptr) they run
+         * one after another, in order, on the calling thread.
+         * @param pool The pool to run on, or nullptr.
+         * @param n Number of positions.
+         * @param grain Positions per chunk.
+         * @param f Callable taking (size_t begin, size_t end).
+         * @throw std::invalid_argument If grain is zero.
+         */
+        template<typename F>
+        void for_each_chunk(ThreadPool* pool, size_t n, size_t grain, F f) {
+            if (grain == 0) {
+                throw std::invalid_argument("Grain must be positive");
+            }
+            size_t chunks = (n + grain - 1) / grain;
+            if (chunks <= 1 || pool == nullptr) {
+                for (size_t begin = 0; begin < n; begin += grain) {
+                    f(begin, std::min(n, begin + grain));
+                }
+                return;
+            }
+            pool->run_chunks(chunks, [&](size_t c) {
+                f(c * grain, std::min(n, (c + 1) * grain));
+            });
+        }
+
+        /**
+         * @brief The default pool on multi-core machines, nullptr (run inline) otherwise.
+         */
+        inline ThreadPool* default_parallel_pool() {
+            return parallel_hardware() ? &default_pool() : nullptr;
+        }
+
+        /**
+         * @brief Reduces [0, n) chunk by chunk, in parallel above the threshold.
+         *
+         * Partial results are combined in ascending chunk order, so the result
+         * only depends on how many chunks were used, not on thread timing.
+         * @param n Number of positions.
+         * @param threshold Minimum n for a parallel split.
+         * @param map Callable (size_t begin, size_t end) -> R for one chunk.
+         * @param combine Callable (R, R) -> R merging adjacent chunk results.
+         * @return The combined result (map(0, 0) when n is zero).
+         */
+        template<typename R, typename Map, typename Combine>
+        R parallel_reduce(size_t n, size_t threshold, Map map, Combine combine) {
+            if (n < threshold || !parallel_hardware()) {
+                return map(size_t{0}, n);
+            }
+            std::vector<std::pair<size_t, R>> partials;
+            std::mutex partials_mutex;
+            parallel_chunks(n, threshold, [&](size_t begin, size_t end) {
+                R partial = map(begin, end);
+                std::lock_guard<std::mutex> lock(partials_mutex);
+                partials.emplace_back(begin, std::move(partial));
+            });
+            std::sort(partials.begin(), partials.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+            R result = std::move(partials[0].second);
+            for (size_t i = 1; i < partials.size(); ++i) {
+                result = combine(result, partials[i].second);
+            }
+            return result;
+        }
+    }
+
+}
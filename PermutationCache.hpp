@@ -0,0 +1,567 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <chrono>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "ThreadPool.hpp"
+#include "Instrumentation.hpp"
+#include "MemoryUsage.hpp"
+#include "Trace.hpp"
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief A built permutation that reports its buffer to an IndexMemory
+         * for as long as anyone (cache, iterator, future) holds it. The
+         * reference is weak, so a cached permutation does not keep its own
+         * cache alive; once the cache is gone there is nothing to report to.
+         */
+        struct TrackedPermutation {
+            std::vector<size_t> indices;
+            std::weak_ptr<IndexMemory> memory;
+            size_t bytes = 0;
+
+            ~TrackedPermutation() {
+                if (auto tracker = memory.lock()) {
+                    tracker->release(bytes);
+                }
+            }
+        };
+
+        /**
+         * @brief One address per policy type, used as a cache key without RTTI.
+         */
+        template<typename Policy>
+        inline const char policy_tag = 0;
+
+        /**
+         * @brief Whether a policy's permutation may be cached by type.
+         *
+         * Defaults to std::is_empty; a policy can override it with a
+         * static constexpr bool cacheable member.
+         */
+        template<typename Policy, typename = void>
+        struct is_cacheable : std::bool_constant<std::is_empty_v<Policy>> {};
+
+        template<typename Policy>
+        struct is_cacheable<Policy, std::void_t<decltype(Policy::cacheable)>>
+            : std::bool_constant<Policy::cacheable> {};
+
+        /**
+         * @brief Whether a policy's builder is known to produce a permutation.
+         *
+         * The output of every builder is range-checked; that of untrusted ones
+         * (the default) is also checked for repeated indices. A policy opts
+         * out of the latter with a static constexpr bool trusted member.
+         */
+        template<typename Policy, typename = void>
+        struct is_trusted : std::false_type {};
+
+        template<typename Policy>
+        struct is_trusted<Policy, std::void_t<decltype(Policy::trusted)>>
+            : std::bool_constant<Policy::trusted> {};
+
+        /**
+         * @brief Checks that indices holds a permutation of [0, indices.size()).
+         * Repeats are found in place, by marking visited indices with the top
+         * bit, which no valid index has.
+         * @param indices The builder's output.
+         * @param check_repeats False to check the range only.
+         * @throw std::invalid_argument If an index is out of range or repeated.
+         */
+        inline void validate_permutation(std::vector<size_t>& indices, bool check_repeats) {
+            const size_t n = indices.size();
+            for (size_t index : indices) {
+                if (index >= n) {
+                    throw std::invalid_argument("Permutation builder produced index out of range");
+                }
+            }
+            if (!check_repeats) {
+                return;
+            }
+            constexpr size_t seen = ~(SIZE_MAX >> 1);
+            for (size_t k = 0; k < n; ++k) {
+                size_t index = indices[k] & ~seen;
+                if (indices[index] & seen) {
+                    throw std::invalid_argument("Permutation builder produced repeated index");
+                }
+                indices[index] |= seen;
+            }
+            for (size_t& index : indices) {
+                index &= ~seen;
+            }
+        }
+
+        /**
+         * @brief Span name of a policy's permutation build: its trace_name member if it has one.
+         */
+        template<typename Policy, typename = void>
+        struct trace_name_of {
+            static constexpr const char* value = "permutation build";
+        };
+
+        template<typename Policy>
+        struct trace_name_of<Policy, std::void_t<decltype(Policy::trace_name)>> {
+            static constexpr const char* value = Policy::trace_name;
+        };
+
+        /**
+         * @brief Runs a permutation policy's builder and validates its output.
+         * @param policy The permutation policy.
+         * @param data The container's elements.
+         * @param memory Accounts for the permutation's buffer until it is freed (may be empty).
+         * @return The built permutation.
+         * @throw std::invalid_argument If the builder does not return a permutation of data's indices.
+         */
+        template<typename Policy, typename T>
+        std::shared_ptr<const std::vector<size_t>> build_permutation(const Policy& policy,
+                                                                     const std::vector<T>& data,
+                                                                     const std::weak_ptr<IndexMemory>& memory) {
+            MYCONTAINER_TRACE_SPAN(trace_name_of<Policy>::value, data.size());
+            auto built = std::make_shared<TrackedPermutation>();
+            if (!data.empty()) {
+                policy.build(data, built->indices);
+            }
+            if (built->indices.size() != data.size()) {
+                throw std::invalid_argument("Permutation builder produced wrong number of indices");
+            }
+            validate_permutation(built->indices, !is_trusted<Policy>::value);
+            note_index_buffer(built->indices.size());
+            built->bytes = built->indices.capacity() * sizeof(size_t);
+            built->memory = memory;
+            if (auto tracker = memory.lock()) {
+                tracker->acquire(built->bytes);
+            }
+            return std::shared_ptr<const std::vector<size_t>>(built, &built->indices);
+        }
+    }
+
+    /**
+     * @brief Future for a permutation being built in the background.
+     */
+    using PermutationFuture = std::shared_future<std::shared_ptr<const std::vector<size_t>>>;
+
+    /**
+     * @brief Per-container cache of permutations built by permutation policies.
+     *
+     * Only cacheable (by default: stateless) policies are cached, keyed by their
+     * type; a policy carrying state may produce a different permutation per
+     * instance, so it is rebuilt for every begin iterator. The owner must
+     * clear() the cache on every mutation it makes itself, and pass a new
+     * generation to lookups once its data may have been written from outside;
+     * entries from an older generation, or of a different size than the data,
+     * are rebuilt. It must hold the cache in a shared_ptr (index buffers are
+     * only accounted for then). Lookups are synchronized,
+     * so several readers of one immutable container may share the cache; two
+     * readers missing at once may both build, and the first result is kept.
+     *
+     * A synchronous miss allocates nothing but the permutation itself. An
+     * entry started by build_async() may still be under construction;
+     * readers then wait for it, and if no thread has started it yet, the
+     * reader builds it itself, so waiting never depends on a free pool worker.
+     */
+    class PermutationCache : public std::enable_shared_from_this<PermutationCache> {
+    private:
+        using Permutation = std::shared_ptr<const std::vector<size_t>>;
+        using Memory = std::weak_ptr<detail::IndexMemory>;
+        using Make = std::function<Permutation(const Memory&)>;
+
+        /**
+         * @brief A background permutation build that runs exactly once, on whichever thread claims it first.
+         */
+        struct Build {
+            std::atomic<bool> claimed{false};
+            std::promise<Permutation> promise;
+            PermutationFuture result = promise.get_future().share();
+            Make make;
+            Memory memory;
+
+            void run() {
+                if (claimed.exchange(true, std::memory_order_acq_rel)) {
+                    return;
+                }
+                try {
+                    promise.set_value(make(memory));
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
+                }
+                make = nullptr;
+            }
+        };
+
+        /**
+         * @brief A cached permutation, or the background build that will produce it.
+         */
+        struct Entry {
+            const void* key = nullptr;
+            Permutation ready;
+            std::shared_ptr<Build> pending;
+        };
+
+        // The built-in sorted orders fit inline, so caching them never allocates.
+        static constexpr size_t inline_entries = 4;
+        Entry entries[inline_entries];
+        size_t inline_count = 0;
+        std::vector<Entry> overflow;
+        uint64_t generation = 0;
+        mutable std::mutex lock;
+        detail::IndexMemory index_memory;
+
+        /**
+         * @brief Returns a weak handle to the index-buffer accounting, empty if the cache is not shared-owned.
+         */
+        Memory memory_tracker() {
+            std::shared_ptr<PermutationCache> self = weak_from_this().lock();
+            if (!self) {
+                return Memory();
+            }
+            return std::shared_ptr<detail::IndexMemory>(self, &index_memory);
+        }
+#ifdef MYCONTAINER_INSTRUMENT
+        std::shared_ptr<detail::InstrumentSink> sink = std::make_shared<detail::InstrumentSink>();
+
+        /**
+         * @brief Wraps a build so that its cost is added to this cache's statistics.
+         */
+        template<typename F>
+        auto instrumented(F make) const {
+            return [sink = sink, make](const Memory& memory) {
+                return sink->record([&]() { return make(memory); });
+            };
+        }
+#else
+        template<typename F>
+        F instrumented(F make) const {
+            return make;
+        }
+#endif
+
+        /**
+         * @brief Calls f on every entry. Caller holds the lock.
+         */
+        template<typename F>
+        void for_each_entry(F&& f) const {
+            for (size_t i = 0; i < inline_count; ++i) {
+                f(entries[i]);
+            }
+            for (const Entry& entry : overflow) {
+                f(entry);
+            }
+        }
+
+        /**
+         * @brief Drops every entry. Caller holds the lock.
+         */
+        void drop_entries() {
+            for (size_t i = 0; i < inline_count; ++i) {
+                entries[i] = Entry();
+            }
+            inline_count = 0;
+            overflow.clear();
+        }
+
+        /**
+         * @brief Drops the entries of an older data generation. Caller holds the lock.
+         */
+        void adopt(uint64_t data_generation) {
+            if (data_generation != generation) {
+                drop_entries();
+                generation = data_generation;
+            }
+        }
+
+        /**
+         * @brief Finds the entry for key. Caller holds the lock.
+         * @return The entry, or nullptr.
+         */
+        Entry* find(const void* key) {
+            for (size_t i = 0; i < inline_count; ++i) {
+                if (entries[i].key == key) {
+                    return &entries[i];
+                }
+            }
+            for (Entry& entry : overflow) {
+                if (entry.key == key) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Adds an empty entry for key, which must be absent. Caller holds the lock.
+         * @return The new entry.
+         */
+        Entry& insert(const void* key) {
+            if (inline_count < inline_entries) {
+                entries[inline_count] = Entry{key, nullptr, nullptr};
+                return entries[inline_count++];
+            }
+            overflow.push_back(Entry{key, nullptr, nullptr});
+            return overflow.back();
+        }
+
+        /**
+         * @brief Drops the entry for key if it still waits on build. Caller holds the lock.
+         */
+        void erase_pending(const void* key, const std::shared_ptr<Build>& build) {
+            Entry* entry = find(key);
+            if (entry == nullptr || entry->pending != build) {
+                return;
+            }
+            if (!overflow.empty()) {
+                *entry = std::move(overflow.back());
+                overflow.pop_back();
+                return;
+            }
+            Entry& last = entries[inline_count - 1];
+            if (&last != entry) {
+                *entry = std::move(last);
+            }
+            last = Entry();
+            --inline_count;
+        }
+
+        /**
+         * @brief Waits for a background build, running it here if nobody has started it.
+         * The result replaces the pending entry; a failed build is dropped from
+         * the cache so the next request retries.
+         */
+        Permutation await(const void* key, const std::shared_ptr<Build>& build) {
+            build->run();
+            try {
+                Permutation permutation = build->result.get();
+                std::lock_guard<std::mutex> guard(lock);
+                Entry* entry = find(key);
+                if (entry != nullptr && entry->pending == build) {
+                    entry->ready = permutation;
+                    entry->pending.reset();
+                }
+                return permutation;
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                erase_pending(key, build);
+                throw;
+            }
+        }
+
+    public:
+        /**
+         * @brief Builds a policy's permutation without consulting or filling the cache.
+         * @param policy The permutation policy.
+         * @param data The container's elements.
+         * @return Shared, immutable permutation of data indices.
+         */
+        template<typename Policy, typename T>
+        Permutation build(const Policy& policy, const std::vector<T>& data) {
+            return instrumented([&policy, &data](const Memory& memory) {
+                return detail::build_permutation(policy, data, memory);
+            })(memory_tracker());
+        }
+
+        /**
+         * @brief Returns the cached permutation for a policy, building it on a miss
+         * and waiting for it if a background build is in progress.
+         * A cached permutation of a different size than data is stale and is
+         * rebuilt, so a resize the owner did not see never yields indices
+         * past the end of data.
+         * @param policy The permutation policy.
+         * @param data The container's elements.
+         * @param data_generation The owner's current data generation.
+         * @return Shared, immutable permutation of data indices.
+         */
+        template<typename Policy, typename T>
+        Permutation get_or_build(const Policy& policy, const std::vector<T>& data, uint64_t data_generation = 0) {
+            if constexpr (!detail::is_cacheable<Policy>::value) {
+                return build(policy, data);
+            } else {
+                const void* key = &detail::policy_tag<Policy>;
+                std::shared_ptr<Build> pending;
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    adopt(data_generation);
+                    if (Entry* entry = find(key)) {
+                        if (entry->ready && entry->ready->size() == data.size()) {
+                            return entry->ready;
+                        }
+                        pending = entry->pending;
+                    }
+                }
+                if (pending) {
+                    Permutation permutation = await(key, pending);
+                    if (permutation->size() == data.size()) {
+                        return permutation;
+                    }
+                }
+                Permutation permutation = build(policy, data);
+                std::lock_guard<std::mutex> guard(lock);
+                if (Entry* entry = find(key)) {
+                    if (entry->ready && entry->ready->size() == data.size()) {
+                        return entry->ready;
+                    }
+                    entry->ready = permutation;
+                    entry->pending.reset();
+                } else {
+                    insert(key).ready = permutation;
+                }
+                return permutation;
+            }
+        }
+
+        /**
+         * @brief Starts building a policy's permutation on a pool.
+         *
+         * The build keeps data alive and reads only it, so the owner may
+         * detach from data (copy-on-write) while the build runs. For a
+         * cacheable policy the result is stored and later get_or_build()
+         * calls use or wait for it; other policies are built but not cached.
+         * @param policy The permutation policy.
+         * @param data Immutable elements to build from.
+         * @param pool The pool to build on.
+         * @param data_generation The owner's current data generation.
+         * @return Future for the permutation; it rethrows the builder's exception.
+         */
+        template<typename Policy, typename T>
+        PermutationFuture build_async(const Policy& policy, std::shared_ptr<const std::vector<T>> data, ThreadPool& pool,
+                                      uint64_t data_generation = 0) {
+            auto build = std::make_shared<Build>();
+            build->make = instrumented([policy, data](const Memory& memory) {
+                return detail::build_permutation(policy, *data, memory);
+            });
+            build->memory = memory_tracker();
+            if constexpr (detail::is_cacheable<Policy>::value) {
+                std::lock_guard<std::mutex> guard(lock);
+                adopt(data_generation);
+                const void* key = &detail::policy_tag<Policy>;
+                Entry* entry = find(key);
+                if (entry != nullptr && entry->ready && entry->ready->size() == data->size()) {
+                    build->claimed = true;
+                    build->promise.set_value(entry->ready);
+                    return build->result;
+                }
+                if (entry != nullptr && entry->pending) {
+                    return entry->pending->result;
+                }
+                if (entry != nullptr) {
+                    entry->ready.reset();
+                    entry->pending = build;
+                } else {
+                    insert(key).pending = build;
+                }
+            }
+            pool.submit([build]() { build->run(); });
+            return build->result;
+        }
+
+        /**
+         * @brief Drops every cached permutation. Live iterators keep their own copy,
+         * and builds in progress complete for whoever is waiting on them.
+         */
+        void clear() {
+            std::lock_guard<std::mutex> guard(lock);
+            drop_entries();
+        }
+
+        /**
+         * @brief Returns an empty cache for a container that stops sharing this one.
+         * Build statistics are carried over, so a container's stats() survive copy-on-write.
+         * @return The new cache.
+         */
+        std::shared_ptr<PermutationCache> detached() const {
+            auto fresh = std::make_shared<PermutationCache>();
+#ifdef MYCONTAINER_INSTRUMENT
+            fresh->sink->assign(sink->snapshot());
+#endif
+            return fresh;
+        }
+
+        /**
+         * @brief Returns the cost of every build made through this cache.
+         * @return The statistics (enabled == false unless MYCONTAINER_INSTRUMENT is defined).
+         */
+        InstrumentationStats stats() const {
+#ifdef MYCONTAINER_INSTRUMENT
+            return sink->snapshot();
+#else
+            return InstrumentationStats();
+#endif
+        }
+
+        /**
+         * @brief Zeroes the build statistics.
+         */
+        void reset_stats() {
+#ifdef MYCONTAINER_INSTRUMENT
+            sink->assign(InstrumentationStats());
+#endif
+        }
+
+        /**
+         * @brief Returns the bytes of the permutations currently in the cache (finished builds only).
+         * @return The byte count.
+         */
+        size_t cached_bytes() const {
+            std::lock_guard<std::mutex> guard(lock);
+            size_t bytes = 0;
+            for_each_entry([&bytes](const Entry& entry) {
+                if (entry.ready) {
+                    bytes += entry.ready->capacity() * sizeof(size_t);
+                    return;
+                }
+                const PermutationFuture& result = entry.pending->result;
+                if (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return;
+                }
+                try {
+                    bytes += result.get()->capacity() * sizeof(size_t);
+                } catch (...) {
+                    // A failed build about to be dropped holds nothing.
+                }
+            });
+            return bytes;
+        }
+
+        /**
+         * @brief Returns the bytes of every index buffer built through this cache
+         * that is still alive, including ones only iterators hold.
+         * @return The byte count.
+         */
+        size_t live_index_bytes() const {
+            return index_memory.live_bytes();
+        }
+
+        /**
+         * @brief Returns the high-water mark of live_index_bytes().
+         * @return The byte count.
+         */
+        size_t peak_index_bytes() const {
+            return index_memory.peak_bytes();
+        }
+
+        /**
+         * @brief Restarts peak_index_bytes() from the current live bytes.
+         */
+        void reset_index_peak() {
+            index_memory.reset_peak();
+        }
+
+        /**
+         * @brief Returns the number of cached (or in-progress) permutations.
+         * @return The number of entries.
+         */
+        size_t size() const {
+            std::lock_guard<std::mutex> guard(lock);
+            return inline_count + overflow.size();
+        }
+    };
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include "OrderedIterator.hpp"
+#include "Bits.hpp"
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Mapping policy for a seeded pseudo-random permutation of [0, n).
+     *
+     * A balanced Feistel network permutes the smallest power-of-four domain
+     * that holds n; positions that land outside [0, n) are fed back through
+     * the network (cycle-walking) until they land inside. The domain is less
+     * than 4n, so a lookup takes a constant number of rounds on average and no
+     * permutation is stored: any position can be computed independently, which
+     * makes the order easy to split across threads.
+     */
+    struct RandomMapping {
+        static constexpr int rounds = 4;
+
+        uint64_t keys[rounds];
+
+        /**
+         * @brief Constructor for the mapping.
+         * @param seed Seed selecting the permutation (same seed, same order).
+         */
+        explicit RandomMapping(uint64_t seed = 0) {
+            uint64_t state = seed;
+            for (int r = 0; r < rounds; ++r) {
+                state = detail::mix64(state);
+                keys[r] = state;
+            }
+        }
+
+        size_t index_at(size_t k, size_t n) const {
+            unsigned half_bits = (detail::bit_width(n - 1) + 1) / 2;
+            uint64_t x = k;
+            do {
+                x = permute(x, half_bits);
+            } while (x >= n);
+            return static_cast<size_t>(x);
+        }
+
+    private:
+        uint64_t permute(uint64_t x, unsigned half_bits) const {
+            uint64_t mask = (uint64_t{1} << half_bits) - 1;
+            uint64_t left = x >> half_bits;
+            uint64_t right = x & mask;
+            for (int r = 0; r < rounds; ++r) {
+                uint64_t next = left ^ (detail::mix64(right ^ keys[r]) & mask);
+                left = right;
+                right = next;
+            }
+            return (left << half_bits) | right;
+        }
+    };
+
+    /**
+     * @brief Iterator over the container in seeded pseudo-random order.
+     */
+    template<typename T>
+    using RandomOrder = OrderedIterator<T, RandomMapping>;
+
+}
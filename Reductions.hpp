@@ -0,0 +1,408 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Simd.hpp"
+#include "Parallel.hpp"
+
+#if defined(__GNUC__)
+#define MYCONTAINER_VECTOR_KERNELS 1
+#define MYCONTAINER_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define MYCONTAINER_VECTOR_KERNELS 0
+#define MYCONTAINER_ALWAYS_INLINE inline
+#endif
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Floating-point summation strategy for MyContainer::sum() and mean().
+     *
+     * Fast uses the widest accumulators the CPU offers, so the rounding of the
+     * result may differ between machines and thread counts. Deterministic
+     * always sums fixed blocks with the same 8-lane association and combines
+     * the block sums in order, giving bit-identical results on every
+     * instruction set and thread count. Integer sums are exact either way.
+     */
+    enum class Summation { Fast, Deterministic };
+
+    namespace detail {
+        /**
+         * @brief Element types with vectorized reduction kernels.
+         */
+        template<typename E>
+        inline constexpr bool vector_reducible =
+            (std::is_integral_v<E> && !std::is_same_v<E, bool>) ||
+            std::is_same_v<E, float> || std::is_same_v<E, double>;
+
+        /**
+         * @brief Accumulator type of sum(): double for floating point, 64-bit for integers.
+         */
+        template<typename E>
+        using sum_type = std::conditional_t<std::is_floating_point_v<E>, double,
+                         std::conditional_t<std::is_signed_v<E>, long long, unsigned long long>>;
+
+        /**
+         * @brief Elements per block of the deterministic summation.
+         */
+        inline constexpr size_t deterministic_block = 8192;
+
+        template<typename E, typename Acc>
+        Acc scalar_sum(const E* p, size_t n) {
+            Acc total = Acc();
+            for (size_t i = 0; i < n; ++i) {
+                total += static_cast<Acc>(p[i]);
+            }
+            return total;
+        }
+
+        /**
+         * @brief Whether x is a NaN (never true for non-floating-point types).
+         */
+        template<typename E>
+        bool is_nan(const E& x) {
+            if constexpr (std::is_floating_point_v<E>) {
+                return x != x;
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Minimum and maximum (n must be at least 1); a NaN makes both NaN.
+         */
+        template<typename E>
+        std::pair<E, E> scalar_minmax(const E* p, size_t n) {
+            E low = p[0];
+            E high = p[0];
+            for (size_t i = 0; i < n; ++i) {
+                if (is_nan(p[i])) return {p[i], p[i]};
+                if (p[i] < low) low = p[i];
+                if (high < p[i]) high = p[i];
+            }
+            return {low, high};
+        }
+
+        /**
+         * @brief Combines the minmax of two ranges, propagating a NaN from either.
+         */
+        template<typename E>
+        std::pair<E, E> merge_minmax(const std::pair<E, E>& a, const std::pair<E, E>& b) {
+            if (is_nan(a.first)) return a;
+            if (is_nan(b.first)) return b;
+            return {b.first < a.first ? b.first : a.first, a.second < b.second ? b.second : a.second};
+        }
+
+#if MYCONTAINER_VECTOR_KERNELS
+        template<typename E, size_t Lanes>
+        struct VectorOf {
+            typedef E type __attribute__((vector_size(Lanes * sizeof(E))));
+        };
+
+        template<size_t Size> struct lane_mask;
+        template<> struct lane_mask<1> { using type = int8_t; };
+        template<> struct lane_mask<2> { using type = int16_t; };
+        template<> struct lane_mask<4> { using type = int32_t; };
+        template<> struct lane_mask<8> { using type = int64_t; };
+
+        template<typename V, typename E>
+        MYCONTAINER_ALWAYS_INLINE void load_vector(V& v, const E* p) {
+            std::memcpy(&v, p, sizeof(v));
+        }
+
+        /**
+         * @brief Sum with four Bytes-wide accumulators (elements widened to sum_type).
+         */
+        template<typename E, size_t Bytes>
+        MYCONTAINER_ALWAYS_INLINE sum_type<E> sum_kernel(const E* p, size_t n) {
+            using Acc = sum_type<E>;
+            constexpr size_t L = Bytes / sizeof(Acc);
+            typedef typename VectorOf<Acc, L>::type AccVec;
+            typedef typename VectorOf<E, L>::type InVec;
+            AccVec acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+            size_t i = 0;
+            InVec in0, in1, in2, in3;
+            for (; i + 4 * L <= n; i += 4 * L) {
+                load_vector(in0, p + i);
+                load_vector(in1, p + i + L);
+                load_vector(in2, p + i + 2 * L);
+                load_vector(in3, p + i + 3 * L);
+                acc0 += __builtin_convertvector(in0, AccVec);
+                acc1 += __builtin_convertvector(in1, AccVec);
+                acc2 += __builtin_convertvector(in2, AccVec);
+                acc3 += __builtin_convertvector(in3, AccVec);
+            }
+            for (; i + L <= n; i += L) {
+                load_vector(in0, p + i);
+                acc0 += __builtin_convertvector(in0, AccVec);
+            }
+            AccVec acc = (acc0 + acc1) + (acc2 + acc3);
+            Acc total = Acc();
+            for (size_t lane = 0; lane < L; ++lane) {
+                total += acc[lane];
+            }
+            return total + scalar_sum<E, Acc>(p + i, n - i);
+        }
+
+        /**
+         * @brief Canonical 8-lane block sum: element i always lands in lane i % 8
+         * and lanes combine pairwise, so every instruction set rounds identically.
+         */
+        template<typename E>
+        MYCONTAINER_ALWAYS_INLINE double canonical_block_sum(const E* p, size_t n) {
+            typedef VectorOf<double, 8>::type AccVec;
+            typedef typename VectorOf<E, 8>::type InVec;
+            AccVec acc = {};
+            size_t i = 0;
+            InVec in;
+            for (; i + 8 <= n; i += 8) {
+                load_vector(in, p + i);
+                acc += __builtin_convertvector(in, AccVec);
+            }
+            for (size_t lane = 0; i < n; ++i, ++lane) {
+                acc[lane] += static_cast<double>(p[i]);
+            }
+            return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+        }
+
+        /**
+         * @brief Minimum and maximum in one pass (n must be at least 1). For
+         * floating point, a NaN anywhere makes both NaN, independent of the
+         * lane width (vector min/max would otherwise keep or drop it by position).
+         */
+        template<typename E, size_t Bytes>
+        MYCONTAINER_ALWAYS_INLINE std::pair<E, E> minmax_kernel(const E* p, size_t n) {
+            constexpr size_t L = Bytes / sizeof(E);
+            typedef typename VectorOf<E, L>::type Vec;
+            if (n < L) {
+                return scalar_minmax(p, n);
+            }
+            Vec low, high, v;
+            load_vector(low, p);
+            high = low;
+            [[maybe_unused]] auto unordered = low != low;
+            size_t i = L;
+            for (; i + L <= n; i += L) {
+                load_vector(v, p + i);
+                low = v < low ? v : low;
+                high = high < v ? v : high;
+                if constexpr (std::is_floating_point_v<E>) {
+                    unordered |= v != v;
+                }
+            }
+            if constexpr (std::is_floating_point_v<E>) {
+                for (size_t lane = 0; lane < L; ++lane) {
+                    if (unordered[lane]) {
+                        E nan = std::numeric_limits<E>::quiet_NaN();
+                        return {nan, nan};
+                    }
+                }
+            }
+            std::pair<E, E> result{low[0], high[0]};
+            for (size_t lane = 1; lane < L; ++lane) {
+                if (low[lane] < result.first) result.first = low[lane];
+                if (result.second < high[lane]) result.second = high[lane];
+            }
+            if (i < n) {
+                result = merge_minmax(result, scalar_minmax(p + i, n - i));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Counts elements equal to value. Lane counters are flushed before
+         * they can overflow their (element-sized) integer lanes.
+         */
+        template<typename E, size_t Bytes>
+        MYCONTAINER_ALWAYS_INLINE size_t count_kernel(const E* p, size_t n, E value) {
+            constexpr size_t L = Bytes / sizeof(E);
+            using Mask = typename lane_mask<sizeof(E)>::type;
+            typedef typename VectorOf<E, L>::type Vec;
+            typedef typename VectorOf<Mask, L>::type MaskVec;
+            constexpr size_t flush_every = std::min<size_t>(size_t{1} << 20,
+                static_cast<size_t>(std::numeric_limits<Mask>::max()));
+            Vec needle = value - Vec{};
+            Vec v;
+            size_t total = 0;
+            size_t i = 0;
+            while (i + L <= n) {
+                MaskVec hits = {};
+                for (size_t rounds = 0; rounds < flush_every && i + L <= n; ++rounds, i += L) {
+                    load_vector(v, p + i);
+                    hits -= (MaskVec)(v == needle);
+                }
+                for (size_t lane = 0; lane < L; ++lane) {
+                    total += static_cast<size_t>(hits[lane]);
+                }
+            }
+            for (; i < n; ++i) {
+                total += (p[i] == value) ? 1 : 0;
+            }
+            return total;
+        }
+
+#if MYCONTAINER_X86_SIMD
+#define MYCONTAINER_DEFINE_REDUCTIONS(suffix, target_isa, bytes)                              \
+        template<typename E>                                                                  \
+        __attribute__((target(target_isa)))                                                   \
+        sum_type<E> sum_##suffix(const E* p, size_t n) {                                      \
+            return sum_kernel<E, bytes>(p, n);                                                \
+        }                                                                                     \
+        template<typename E>                                                                  \
+        __attribute__((target(target_isa)))                                                   \
+        double canonical_sum_##suffix(const E* p, size_t n) {                                 \
+            return canonical_block_sum(p, n);                                                 \
+        }                                                                                     \
+        template<typename E>                                                                  \
+        __attribute__((target(target_isa)))                                                   \
+        std::pair<E, E> minmax_##suffix(const E* p, size_t n) {                               \
+            return minmax_kernel<E, bytes>(p, n);                                             \
+        }                                                                                     \
+        template<typename E>                                                                  \
+        __attribute__((target(target_isa)))                                                   \
+        size_t count_##suffix(const E* p, size_t n, E value) {                                \
+            return count_kernel<E, bytes>(p, n, value);                                       \
+        }
+
+        MYCONTAINER_DEFINE_REDUCTIONS(sse2, "sse2", 16)
+        MYCONTAINER_DEFINE_REDUCTIONS(avx2, "avx2", 32)
+        MYCONTAINER_DEFINE_REDUCTIONS(avx512, "avx512f", 64)
+#undef MYCONTAINER_DEFINE_REDUCTIONS
+
+#define MYCONTAINER_DISPATCH(name, ...)                                                       \
+        switch (simd_level()) {                                                               \
+            case SimdLevel::AVX512: return name##_avx512(__VA_ARGS__);                        \
+            case SimdLevel::AVX2: return name##_avx2(__VA_ARGS__);                            \
+            case SimdLevel::SSE2: return name##_sse2(__VA_ARGS__);                            \
+            default: break;                                                                   \
+        }
+#else
+#define MYCONTAINER_DISPATCH(name, ...)
+#endif
+#endif
+
+        /**
+         * @brief Sum of a chunk with the widest kernel available.
+         */
+        template<typename E>
+        sum_type<E> sum_range(const E* p, size_t n) {
+#if MYCONTAINER_VECTOR_KERNELS
+            if constexpr (vector_reducible<E>) {
+                MYCONTAINER_DISPATCH(sum, p, n)
+                return sum_kernel<E, 16>(p, n);
+            }
+#endif
+            return scalar_sum<E, sum_type<E>>(p, n);
+        }
+
+        /**
+         * @brief One deterministic block (at most deterministic_block elements).
+         */
+        template<typename E>
+        double canonical_sum_range(const E* p, size_t n) {
+#if MYCONTAINER_VECTOR_KERNELS
+            if constexpr (vector_reducible<E>) {
+                MYCONTAINER_DISPATCH(canonical_sum, p, n)
+                return canonical_block_sum(p, n);
+            }
+#endif
+            double lanes[8] = {};
+            for (size_t i = 0; i < n; ++i) {
+                lanes[i % 8] += static_cast<double>(p[i]);
+            }
+            return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        }
+
+        template<typename E>
+        std::pair<E, E> minmax_range(const E* p, size_t n) {
+#if MYCONTAINER_VECTOR_KERNELS
+            if constexpr (vector_reducible<E>) {
+                MYCONTAINER_DISPATCH(minmax, p, n)
+                return minmax_kernel<E, 16>(p, n);
+            }
+#endif
+            return scalar_minmax(p, n);
+        }
+
+        template<typename E>
+        size_t count_range(const E* p, size_t n, const E& value) {
+#if MYCONTAINER_VECTOR_KERNELS
+            if constexpr (vector_reducible<E>) {
+                MYCONTAINER_DISPATCH(count, p, n, value)
+                return count_kernel<E, 16>(p, n, value);
+            }
+#endif
+            return static_cast<size_t>(std::count(p, p + n, value));
+        }
+
+#ifdef MYCONTAINER_DISPATCH
+#undef MYCONTAINER_DISPATCH
+#endif
+
+        /**
+         * @brief Deterministic floating-point sum: canonical block sums (computed in
+         * parallel above the threshold) added in block order.
+         */
+        template<typename E>
+        double deterministic_sum(const E* p, size_t n) {
+            size_t blocks = (n + deterministic_block - 1) / deterministic_block;
+            std::vector<double> block_sums(blocks);
+            parallel_chunks(blocks, parallel_threshold / deterministic_block, [&](size_t begin, size_t end) {
+                for (size_t b = begin; b < end; ++b) {
+                    size_t first = b * deterministic_block;
+                    block_sums[b] = canonical_sum_range(p + first, std::min(deterministic_block, n - first));
+                }
+            });
+            double total = 0.0;
+            for (double block_sum : block_sums) {
+                total += block_sum;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Sum of [p, p + n), split across threads above the parallel threshold.
+         * @param p The elements.
+         * @param n Number of elements.
+         * @param mode Fast or deterministic floating-point summation.
+         */
+        template<typename E>
+        sum_type<E> sum(const E* p, size_t n, Summation mode) {
+            if constexpr (std::is_floating_point_v<E>) {
+                if (mode == Summation::Deterministic) {
+                    return deterministic_sum(p, n);
+                }
+            }
+            (void)mode;
+            return parallel_reduce<sum_type<E>>(n, parallel_threshold,
+                [p](size_t begin, size_t end) { return sum_range(p + begin, end - begin); },
+                [](sum_type<E> a, sum_type<E> b) { return a + b; });
+        }
+
+        /**
+         * @brief Minimum and maximum of [p, p + n), n >= 1. A NaN element makes both NaN.
+         */
+        template<typename E>
+        std::pair<E, E> minmax(const E* p, size_t n) {
+            return parallel_reduce<std::pair<E, E>>(n, parallel_threshold,
+                [p](size_t begin, size_t end) { return minmax_range(p + begin, end - begin); },
+                [](const std::pair<E, E>& a, const std::pair<E, E>& b) { return merge_minmax(a, b); });
+        }
+
+        /**
+         * @brief Number of elements of [p, p + n) equal to value.
+         */
+        template<typename E>
+        size_t count(const E* p, size_t n, const E& value) {
+            return parallel_reduce<size_t>(n, parallel_threshold,
+                [p, &value](size_t begin, size_t end) { return count_range(p + begin, end - begin, value); },
+                [](size_t a, size_t b) { return a + b; });
+        }
+    }
+
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include "Simd.hpp"
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief Element types with vectorized search/compaction kernels.
+         */
+        template<typename E>
+        inline constexpr bool simd_searchable = simd_gatherable<E> && !std::is_same_v<E, bool>;
+
+#if MYCONTAINER_X86_SIMD
+        template<typename E>
+        inline auto lane_bits(E value) {
+            using Bits = std::conditional_t<sizeof(E) == 8, long long, int>;
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        /**
+         * @brief permutevar8x32 controls moving the kept lanes of an 8 x 32-bit
+         * (Wide = false) or 4 x 64-bit (Wide = true) vector to the front.
+         */
+        template<bool Wide>
+        struct CompactTable {
+            static constexpr size_t lanes = Wide ? 4 : 8;
+            std::array<std::array<int, 8>, (size_t{1} << lanes)> control{};
+
+            constexpr CompactTable() {
+                for (size_t keep = 0; keep < (size_t{1} << lanes); ++keep) {
+                    size_t out = 0;
+                    for (size_t lane = 0; lane < lanes; ++lane) {
+                        if (keep & (size_t{1} << lane)) {
+                            if (Wide) {
+                                control[keep][2 * out] = static_cast<int>(2 * lane);
+                                control[keep][2 * out + 1] = static_cast<int>(2 * lane + 1);
+                            } else {
+                                control[keep][out] = static_cast<int>(lane);
+                            }
+                            ++out;
+                        }
+                    }
+                }
+            }
+        };
+
+        template<bool Wide>
+        inline constexpr CompactTable<Wide> compact_table{};
+
+        /**
+         * @brief All-ones lanes where p[0..L) == needle (floating types compare as
+         * floating point, so -0.0 == 0.0 and NaN never matches).
+         */
+        template<typename E>
+        __attribute__((target("avx2")))
+        inline __m256i equal_lanes_avx2(const E* p, __m256i needle) {
+            if constexpr (std::is_same_v<E, double>) {
+                return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+            } else if constexpr (std::is_same_v<E, float>) {
+                return _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+            } else if constexpr (sizeof(E) == 8) {
+                return _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), needle);
+            } else {
+                return _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), needle);
+            }
+        }
+
+        template<typename E>
+        __attribute__((target("avx2")))
+        size_t find_equal_avx2(const E* p, size_t n, E value) {
+            constexpr size_t L = 32 / sizeof(E);
+            __m256i needle = (sizeof(E) == 8) ? _mm256_set1_epi64x(lane_bits(value))
+                                              : _mm256_set1_epi32(static_cast<int>(lane_bits(value)));
+            size_t i = 0;
+            for (; i + 4 * L <= n; i += 4 * L) {
+                __m256i m0 = equal_lanes_avx2(p + i, needle);
+                __m256i m1 = equal_lanes_avx2(p + i + L, needle);
+                __m256i m2 = equal_lanes_avx2(p + i + 2 * L, needle);
+                __m256i m3 = equal_lanes_avx2(p + i + 3 * L, needle);
+                __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+                if (!_mm256_testz_si256(any, any)) {
+                    break;
+                }
+            }
+            for (; i + L <= n; i += L) {
+                unsigned bytes = static_cast<unsigned>(_mm256_movemask_epi8(equal_lanes_avx2(p + i, needle)));
+                if (bytes != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(bytes)) / sizeof(E);
+                }
+            }
+            for (; i < n; ++i) {
+                if (p[i] == value) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        template<typename E>
+        __attribute__((target("avx2")))
+        size_t remove_equal_avx2(E* p, size_t n, E value) {
+            constexpr size_t L = 32 / sizeof(E);
+            constexpr unsigned all = (1u << L) - 1;
+            __m256i needle = (sizeof(E) == 8) ? _mm256_set1_epi64x(lane_bits(value))
+                                              : _mm256_set1_epi32(static_cast<int>(lane_bits(value)));
+            const auto& table = compact_table<sizeof(E) == 8>.control;
+            size_t kept = 0;
+            size_t i = 0;
+            for (; i + L <= n; i += L) {
+                __m256i equal = equal_lanes_avx2(p + i, needle);
+                unsigned keep = all & ~static_cast<unsigned>(sizeof(E) == 8
+                    ? _mm256_movemask_pd(_mm256_castsi256_pd(equal))
+                    : _mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                __m256i control = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table[keep].data()));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + kept), _mm256_permutevar8x32_epi32(v, control));
+                kept += static_cast<size_t>(__builtin_popcount(keep));
+            }
+            for (; i < n; ++i) {
+                if (!(p[i] == value)) {
+                    p[kept++] = p[i];
+                }
+            }
+            return kept;
+        }
+
+        template<typename E>
+        __attribute__((target("avx512f")))
+        inline unsigned equal_lanes_avx512(const E* p, E value) {
+            if constexpr (std::is_same_v<E, double>) {
+                return _mm512_cmp_pd_mask(_mm512_loadu_pd(p), _mm512_set1_pd(value), _CMP_EQ_OQ);
+            } else if constexpr (std::is_same_v<E, float>) {
+                return _mm512_cmp_ps_mask(_mm512_loadu_ps(p), _mm512_set1_ps(value), _CMP_EQ_OQ);
+            } else if constexpr (sizeof(E) == 8) {
+                return _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(p), _mm512_set1_epi64(lane_bits(value)));
+            } else {
+                return _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(p), _mm512_set1_epi32(lane_bits(value)));
+            }
+        }
+
+        template<typename E>
+        __attribute__((target("avx512f")))
+        size_t find_equal_avx512(const E* p, size_t n, E value) {
+            constexpr size_t L = 64 / sizeof(E);
+            size_t i = 0;
+            for (; i + 4 * L <= n; i += 4 * L) {
+                unsigned any = equal_lanes_avx512(p + i, value) | equal_lanes_avx512(p + i + L, value) |
+                               equal_lanes_avx512(p + i + 2 * L, value) | equal_lanes_avx512(p + i + 3 * L, value);
+                if (any != 0) {
+                    break;
+                }
+            }
+            for (; i + L <= n; i += L) {
+                unsigned lanes = equal_lanes_avx512(p + i, value);
+                if (lanes != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(lanes));
+                }
+            }
+            for (; i < n; ++i) {
+                if (p[i] == value) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        template<typename E>
+        __attribute__((target("avx512f")))
+        size_t remove_equal_avx512(E* p, size_t n, E value) {
+            constexpr size_t L = 64 / sizeof(E);
+            constexpr unsigned all = (1u << L) - 1;
+            size_t kept = 0;
+            size_t i = 0;
+            for (; i + L <= n; i += L) {
+                unsigned keep = all & ~equal_lanes_avx512(p + i, value);
+                __m512i v = _mm512_loadu_si512(p + i);
+                if constexpr (sizeof(E) == 8) {
+                    _mm512_mask_compressstoreu_epi64(p + kept, static_cast<__mmask8>(keep), v);
+                } else {
+                    _mm512_mask_compressstoreu_epi32(p + kept, static_cast<__mmask16>(keep), v);
+                }
+                kept += static_cast<size_t>(__builtin_popcount(keep));
+            }
+            for (; i < n; ++i) {
+                if (!(p[i] == value)) {
+                    p[kept++] = p[i];
+                }
+            }
+            return kept;
+        }
+#endif
+
+        /**
+         * @brief Position of the first element equal to value, or n if none.
+         * 4- and 8-byte arithmetic types compare a full vector per instruction.
+         */
+        template<typename E>
+        size_t find_equal(const E* p, size_t n, const E& value) {
+#if MYCONTAINER_X86_SIMD
+            if constexpr (simd_searchable<E>) {
+                switch (simd_level()) {
+                    case SimdLevel::AVX512: return find_equal_avx512(p, n, value);
+                    case SimdLevel::AVX2: return find_equal_avx2(p, n, value);
+                    default: break;
+                }
+            }
+#endif
+            return static_cast<size_t>(std::find(p, p + n, value) - p);
+        }
+
+        /**
+         * @brief Removes every element equal to value from [p, p + n) in place,
+         * keeping the order of the rest (like std::remove).
+         * @return Number of elements kept at the front.
+         */
+        template<typename E>
+        size_t remove_equal(E* p, size_t n, const E& value) {
+#if MYCONTAINER_X86_SIMD
+            if constexpr (simd_searchable<E>) {
+                switch (simd_level()) {
+                    case SimdLevel::AVX512: return remove_equal_avx512(p, n, value);
+                    case SimdLevel::AVX2: return remove_equal_avx2(p, n, value);
+                    default: break;
+                }
+            }
+#endif
+            return static_cast<size_t>(std::remove(p, p + n, value) - p);
+        }
+    }
+
+}
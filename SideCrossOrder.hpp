@@ -1,108 +1,41 @@
 #pragma once
-//#include "MyContainer.hpp"
 #include <vector>
-#include <algorithm>
+#include "OrderedIterator.hpp"
+#include "AscendingOrder.hpp"
 
 namespace MyContainerNamespace {
-    template<typename T>
-    class MyContainer;
 
-    template<typename T>
-    class SideCrossOrder {
-    private:
-        const MyContainer<T>& container;
-        std::vector<size_t> indices;
-        size_t current_index;
+    /**
+     * @brief Mapping policy that alternates smallest, largest, second smallest, ...
+     */
+    struct SideCrossMapping {
+        static constexpr bool trusted = true;
+        static constexpr const char* trace_name = "SideCrossOrder index build";
 
-    public:
         /**
-         * @brief Constructor for the SideCrossOrder iterator.
-         * @param cont Reference to the container.
-         * @param pos The starting position (default is 0).
+         * @brief Builds the side-cross permutation from the ascending one.
+         * @param data The container's elements.
+         * @param indices Output: data indices in side-cross order.
          */
-        explicit SideCrossOrder(const MyContainer<T>& cont, size_t pos = 0)
-            : container(cont), current_index(pos) {
-            if (container.empty()) {
-                return;
-            }
-            std::vector<size_t> sorted_indices(container.size());
-            for (size_t i = 0; i < container.size(); ++i) {
-                sorted_indices[i] = i;
-            }
-            
-            std::sort(sorted_indices.begin(), sorted_indices.end(),
-                [this](size_t a, size_t b) {
-                    return container.getData()[a] < container.getData()[b];
-                });
+        template<typename T>
+        void build(const std::vector<T>& data, std::vector<size_t>& indices) const {
+            std::vector<size_t> sorted_indices;
+            AscendingMapping().build(data, sorted_indices);
+            detail::note_index_buffer(sorted_indices.size());
 
-            size_t left = 0;
-            size_t right = sorted_indices.size() - 1;
-            bool take_left = true;
-
-            while (left <= right) {
-                if (take_left) {
-                    indices.push_back(sorted_indices[left]);
-                    ++left;
-                } else {
-                    indices.push_back(sorted_indices[right]);
-                    if (right == 0) break;
-                    --right;
-                }
-                take_left = !take_left;
-            }
-        }
-        /**
-         * @brief Access current element.
-         * @return Reference to the current element.
-         * @throw std::out_of_range If out of bounds
-         */
-        const T& operator*() const {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Iterator out of bounds");
-            }
-            return container.getData()[indices[current_index]];
-        }
-        /**
-         * @brief Pre-increment operator. Advance to next position.
-         * @return Reference after increment.
-         * @throw std::out_of_range If incrementing past end
-         */
-        SideCrossOrder& operator++() {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
+            size_t n = sorted_indices.size();
+            indices.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                indices[k] = (k % 2 == 0) ? sorted_indices[k / 2]
+                                          : sorted_indices[n - 1 - k / 2];
             }
-            ++current_index;
-            return *this;
-        }
-        /**
-         * @brief Post-increment operator. Advance to next position.
-         * @return Copy of the iterator before increment.
-         * @throw std::out_of_range If incrementing past end
-         */
-        SideCrossOrder operator++(int) {
-            if (current_index >= container.size()) {
-                throw std::out_of_range("Cannot increment iterator past end");
-            }
-            SideCrossOrder temp = *this;
-            ++current_index;
-            return temp;
-        }
-        /**
-         * @brief Equality operator.
-         * @param other The other SideCrossOrder to compare with.
-         * @return True if both iterators are equal, false otherwise.
-         */
-        bool operator==(const SideCrossOrder& other) const {
-            return current_index == other.current_index && &container == &other.container;
-        }
-        /**
-         * @brief Inequality operator.
-         * @param other The other SideCrossOrder to compare with.
-         * @return True if both iterators are not equal, false otherwise.
-         */
-        bool operator!=(const SideCrossOrder& other) const {
-            return !(*this == other);
         }
     };
 
-}
\ No newline at end of file
+    /**
+     * @brief Iterator over the container in side-cross order.
+     */
+    template<typename T>
+    using SideCrossOrder = OrderedIterator<T, SideCrossMapping>;
+
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "IndexMap.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MYCONTAINER_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define MYCONTAINER_X86_SIMD 0
+#endif
+
+namespace MyContainerNamespace {
+
+    namespace detail {
+        /**
+         * @brief Instruction-set tiers the vectorized kernels are compiled for.
+         */
+        enum class SimdLevel { Scalar = 0, SSE2 = 1, AVX2 = 2, AVX512 = 3 };
+
+        inline SimdLevel detect_simd_level() {
+#if MYCONTAINER_X86_SIMD
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::AVX2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return SimdLevel::SSE2;
+            }
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        inline SimdLevel& simd_level_cap() {
+            static SimdLevel cap = SimdLevel::AVX512;
+            return cap;
+        }
+
+        /**
+         * @brief The tier kernels dispatch to: what the CPU supports, capped by
+         * limit_simd_level(). Detection runs once.
+         */
+        inline SimdLevel simd_level() {
+            static const SimdLevel detected = detect_simd_level();
+            return detected < simd_level_cap() ? detected : simd_level_cap();
+        }
+
+        /**
+         * @brief Caps the dispatched tier, e.g. to test or compare the fallbacks.
+         * Not thread-safe; call it before running kernels.
+         * @param cap The highest tier kernels may use.
+         */
+        inline void limit_simd_level(SimdLevel cap) {
+            simd_level_cap() = cap;
+        }
+
+        /**
+         * @brief Element types the raw-bit kernels can move: 4- or 8-byte arithmetic types.
+         */
+        template<typename T>
+        inline constexpr bool simd_gatherable =
+            std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+#if MYCONTAINER_X86_SIMD
+        __attribute__((target("avx2")))
+        inline void gather64_avx2(const void* base, const size_t* indices, size_t count, void* out) {
+            const long long* src = static_cast<const long long*>(base);
+            long long* dst = static_cast<long long*>(out);
+            size_t k = 0;
+            for (; k + 4 <= count; k += 4) {
+                if (k + prefetch_distance + 4 <= count) {
+                    for (size_t lane = 0; lane < 4; ++lane) {
+                        prefetch(src + indices[k + prefetch_distance + lane]);
+                    }
+                }
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + k));
+                __m256i values = _mm256_i64gather_epi64(src, idx, 8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), values);
+            }
+            for (; k < count; ++k) {
+                dst[k] = src[indices[k]];
+            }
+        }
+
+        __attribute__((target("avx2")))
+        inline void gather32_avx2(const void* base, const size_t* indices, size_t count, void* out) {
+            const int* src = static_cast<const int*>(base);
+            int* dst = static_cast<int*>(out);
+            size_t k = 0;
+            for (; k + 4 <= count; k += 4) {
+                if (k + prefetch_distance + 4 <= count) {
+                    for (size_t lane = 0; lane < 4; ++lane) {
+                        prefetch(src + indices[k + prefetch_distance + lane]);
+                    }
+                }
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + k));
+                __m128i values = _mm256_i64gather_epi32(src, idx, 4);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), values);
+            }
+            for (; k < count; ++k) {
+                dst[k] = src[indices[k]];
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        inline void gather64_avx512(const void* base, const size_t* indices, size_t count, void* out) {
+            const long long* src = static_cast<const long long*>(base);
+            long long* dst = static_cast<long long*>(out);
+            size_t k = 0;
+            for (; k + 8 <= count; k += 8) {
+                if (k + prefetch_distance + 8 <= count) {
+                    for (size_t lane = 0; lane < 8; ++lane) {
+                        prefetch(src + indices[k + prefetch_distance + lane]);
+                    }
+                }
+                __m512i idx = _mm512_loadu_si512(indices + k);
+                __m512i values = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xFF, idx, src, 8);
+                _mm512_storeu_si512(dst + k, values);
+            }
+            for (; k < count; ++k) {
+                dst[k] = src[indices[k]];
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        inline void gather32_avx512(const void* base, const size_t* indices, size_t count, void* out) {
+            const int* src = static_cast<const int*>(base);
+            int* dst = static_cast<int*>(out);
+            size_t k = 0;
+            for (; k + 8 <= count; k += 8) {
+                if (k + prefetch_distance + 8 <= count) {
+                    for (size_t lane = 0; lane < 8; ++lane) {
+                        prefetch(src + indices[k + prefetch_distance + lane]);
+                    }
+                }
+                __m512i idx = _mm512_loadu_si512(indices + k);
+                __m256i values = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), 0xFF, idx, src, 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), values);
+            }
+            for (; k < count; ++k) {
+                dst[k] = src[indices[k]];
+            }
+        }
+#endif
+
+        /**
+         * @brief Vectorized out[k] = data[indices[k]] for k in [0, count).
+         * @return False if no vector kernel applies; the caller then falls back
+         * to the scalar gather.
+         */
+        template<typename T>
+        bool simd_gather(const T* data, const size_t* indices, size_t count, T* out) {
+#if MYCONTAINER_X86_SIMD
+            if constexpr (simd_gatherable<T>) {
+                SimdLevel level = simd_level();
+                if (level == SimdLevel::AVX512) {
+                    (sizeof(T) == 8 ? gather64_avx512 : gather32_avx512)(data, indices, count, out);
+                    return true;
+                }
+                if (level == SimdLevel::AVX2) {
+                    (sizeof(T) == 8 ? gather64_avx2 : gather32_avx2)(data, indices, count, out);
+                    return true;
+                }
+            }
+#else
+            (void)data; (void)indices; (void)count; (void)out;
+#endif
+            return false;
+        }
+    }
+
+}
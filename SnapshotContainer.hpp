@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "MyContainer.hpp"
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Container whose readers traverse immutable snapshots while writers keep mutating.
+     *
+     * Writers modify a private working copy under a writer lock and publish()
+     * it as a new immutable version; readers pin the current version with
+     * snapshot() and may iterate it in any order for as long as they hold it,
+     * without blocking or being blocked by writers. A version is freed when
+     * its last reader releases it (reference-counted reclamation).
+     *
+     * Published versions keep the working copy's membership filter, so
+     * readers' contains() calls get its fast misses.
+     *
+     * @tparam T The element type.
+     */
+    template<typename T = int>
+    class SnapshotContainer {
+    private:
+        mutable std::mutex writer_lock;
+        MyContainer<T> working;
+        std::shared_ptr<const MyContainer<T>> published = std::make_shared<const MyContainer<T>>();
+        size_t published_version = 0;
+
+    public:
+        SnapshotContainer() = default;
+        SnapshotContainer(const SnapshotContainer&) = delete;
+        SnapshotContainer& operator=(const SnapshotContainer&) = delete;
+
+        /**
+         * @brief Returns the latest published version. Safe from any thread.
+         * The returned container never changes; keep the pointer alive while
+         * any iterator over it is in use.
+         * @return Shared pointer to an immutable container.
+         */
+        std::shared_ptr<const MyContainer<T>> snapshot() const {
+            return std::atomic_load(&published);
+        }
+
+        /**
+         * @brief Stages an element; readers see it after the next publish().
+         * @param element The element to add.
+         */
+        void add(const T& element) {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            working.add(element);
+        }
+
+        /**
+         * @brief Stages a range of elements; readers see them after the next publish().
+         * @param first Iterator to the first element to add.
+         * @param last Iterator past the last element to add.
+         */
+        template<typename InputIt>
+        void add_range(InputIt first, InputIt last) {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            working.add_range(first, last);
+        }
+
+        /**
+         * @brief Stages the removal of all occurrences of an element.
+         * @param element The element to remove.
+         * @throw std::invalid_argument If the element is not in the working copy.
+         */
+        void remove(const T& element) {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            working.remove(element);
+        }
+
+        /**
+         * @brief Applies an arbitrary mutation to the working copy under the writer lock.
+         * @param f Callable taking MyContainer<T>&.
+         */
+        template<typename F>
+        void update(F&& f) {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            f(working);
+        }
+
+        /**
+         * @brief Makes the staged changes visible to new snapshots.
+         * Readers holding older versions are unaffected.
+         * @return The number of the newly published version.
+         */
+        size_t publish() {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            auto next = std::make_shared<MyContainer<T>>(working);
+            std::atomic_store(&published, std::shared_ptr<const MyContainer<T>>(std::move(next)));
+            return ++published_version;
+        }
+
+        /**
+         * @brief Returns how many times publish() has been called.
+         * @return The latest version number (0 before the first publish).
+         */
+        size_t version() const {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            return published_version;
+        }
+
+        /**
+         * @brief Returns the number of elements in the working copy, published or not.
+         * @return The staged size.
+         */
+        size_t staged_size() const {
+            std::lock_guard<std::mutex> guard(writer_lock);
+            return working.size();
+        }
+    };
+
+}
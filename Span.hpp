@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Non-owning view of a contiguous run of elements.
+     *
+     * A minimal stand-in for C++20 std::span, used to hand blocks of elements
+     * to consumers (e.g. vectorized loops) without copying.
+     */
+    template<typename T>
+    class Span {
+    private:
+        T* ptr;
+        size_t count;
+
+    public:
+        using element_type = T;
+        using iterator = T*;
+        using reverse_iterator = std::reverse_iterator<T*>;
+
+        Span() : ptr(nullptr), count(0) {}
+
+        /**
+         * @brief Constructor for the view.
+         * @param first Pointer to the first element.
+         * @param size Number of elements.
+         */
+        Span(T* first, size_t size) : ptr(first), count(size) {}
+
+        T* data() const { return ptr; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        T* begin() const { return ptr; }
+        T* end() const { return ptr + count; }
+        reverse_iterator rbegin() const { return reverse_iterator(end()); }
+        reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+        /**
+         * @brief Accesses an element of the view.
+         * @param index The index of the element.
+         * @return Reference to the element.
+         * @throw std::out_of_range If the index is out of range.
+         */
+        T& operator[](size_t index) const {
+            if (index >= count) {
+                throw std::out_of_range("Index out of range");
+            }
+            return ptr[index];
+        }
+    };
+
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include "Bits.hpp"
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+namespace MyContainerNamespace {
+
+    template<typename T>
+    class MyContainer;
+
+    namespace detail {
+        /**
+         * @brief Ascending permutation produced bucket by bucket (sample sort).
+         *
+         * A sample of the data picks splitters, one O(n) pass scatters the
+         * indices into a power-of-two number of buckets of roughly 2048
+         * elements, and the buckets are then sorted in ascending order and
+         * published as soon as every bucket before them is done. Pool workers and waiting readers share
+         * the work: a reader that needs an unpublished position sorts the
+         * next unclaimed bucket itself rather than just blocking.
+         */
+        template<typename T>
+        class AscendingStream {
+        private:
+            static constexpr size_t bucket_elements = 2048;
+            static constexpr size_t max_buckets = 4096;
+            static constexpr size_t oversampling = 8;
+
+            std::shared_ptr<const std::vector<T>> data;
+            std::vector<size_t> order;
+            std::vector<size_t> bucket_begin;
+            std::unique_ptr<std::atomic<bool>[]> bucket_sorted;
+            size_t buckets = 0;
+            std::atomic<bool> partition_claimed{false};
+            std::atomic<bool> partitioned{false};
+            std::atomic<size_t> next_bucket{0};
+            std::atomic<size_t> ready{0};
+            size_t frontier = 0;
+            std::exception_ptr error;
+            std::mutex lock;
+            std::condition_variable progress;
+
+            void partition() {
+                const std::vector<T>& values = *data;
+                size_t n = values.size();
+                MYCONTAINER_TRACE_SPAN("streaming partition", n);
+                size_t count = size_t{1} << (bit_width(std::clamp<size_t>(n / bucket_elements, 1, max_buckets)) - 1);
+
+                std::vector<T> splitters;
+                if (count > 1) {
+                    size_t samples = std::min(n, count * oversampling);
+                    std::vector<T> sample;
+                    sample.reserve(samples);
+                    for (size_t i = 0; i < samples; ++i) {
+                        sample.push_back(values[mix64(i) % n]);
+                    }
+                    std::sort(sample.begin(), sample.end());
+                    for (size_t b = 1; b < count; ++b) {
+                        splitters.push_back(sample[b * samples / count]);
+                    }
+                }
+
+                std::vector<uint16_t> bucket_of(n);
+                std::vector<size_t> offsets(count + 1, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    // Branch-free upper_bound over the count - 1 splitters (count is a power of two).
+                    size_t b = 0;
+                    for (size_t step = count / 2; step > 0; step /= 2) {
+                        b += (values[i] < splitters[b + step - 1]) ? 0 : step;
+                    }
+                    bucket_of[i] = static_cast<uint16_t>(b);
+                    ++offsets[b + 1];
+                }
+                for (size_t b = 0; b < count; ++b) {
+                    offsets[b + 1] += offsets[b];
+                }
+                order.resize(n);
+                std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < n; ++i) {
+                    order[cursor[bucket_of[i]]++] = i;
+                }
+
+                bucket_begin = std::move(offsets);
+                bucket_sorted.reset(new std::atomic<bool>[count]());
+                buckets = count;
+                std::lock_guard<std::mutex> guard(lock);
+                partitioned.store(true, std::memory_order_release);
+                progress.notify_all();
+            }
+
+            /**
+             * @brief Sorts the next unclaimed bucket and publishes every finished prefix.
+             * @return False if every bucket was already claimed.
+             */
+            bool sort_next_bucket() {
+                size_t b = next_bucket.fetch_add(1, std::memory_order_relaxed);
+                if (b >= buckets) {
+                    return false;
+                }
+                const std::vector<T>& values = *data;
+                {
+                    MYCONTAINER_TRACE_SPAN("streaming bucket sort", bucket_begin[b + 1] - bucket_begin[b]);
+                    std::sort(order.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b]),
+                              order.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b + 1]),
+                              [&values](size_t x, size_t y) { return values[x] < values[y]; });
+                }
+                bucket_sorted[b].store(true, std::memory_order_release);
+                std::lock_guard<std::mutex> guard(lock);
+                while (frontier < buckets && bucket_sorted[frontier].load(std::memory_order_acquire)) {
+                    ++frontier;
+                }
+                ready.store(bucket_begin[frontier], std::memory_order_release);
+                progress.notify_all();
+                return true;
+            }
+
+            /**
+             * @brief Runs f, recording its exception for every waiter before rethrowing it.
+             */
+            template<typename F>
+            void guarded(F f) {
+                try {
+                    f();
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    progress.notify_all();
+                    throw;
+                }
+            }
+
+        public:
+            /**
+             * @brief Constructor for the stream.
+             * @param values Immutable elements to sort (kept alive by the stream).
+             */
+            explicit AscendingStream(std::shared_ptr<const std::vector<T>> values) : data(std::move(values)) {}
+
+            /**
+             * @brief Queues background workers for the stream on a pool.
+             * @param stream The stream (shared with the workers).
+             * @param pool The pool to run on.
+             */
+            static void start(const std::shared_ptr<AscendingStream>& stream, ThreadPool& pool) {
+                for (size_t i = 0; i < pool.size(); ++i) {
+                    pool.submit([stream]() {
+                        try {
+                            stream->work();
+                        } catch (...) {
+                        }
+                    });
+                }
+            }
+
+            /**
+             * @brief Partitions (if nobody has) and sorts buckets until none are left.
+             */
+            void work() {
+                if (!partition_claimed.exchange(true, std::memory_order_acq_rel)) {
+                    guarded([this]() { partition(); });
+                } else {
+                    std::unique_lock<std::mutex> guard(lock);
+                    progress.wait(guard, [this]() { return partitioned.load(std::memory_order_acquire) || error; });
+                    if (error) {
+                        return;
+                    }
+                }
+                while (true) {
+                    bool sorted = false;
+                    guarded([&]() { sorted = sort_next_bucket(); });
+                    if (!sorted) {
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * @brief Blocks until position is final, helping with the work meanwhile.
+             * @param position A position below size().
+             * @throw Whatever partitioning or sorting threw.
+             */
+            void wait_for(size_t position) {
+                while (ready.load(std::memory_order_acquire) <= position) {
+                    if (!partition_claimed.exchange(true, std::memory_order_acq_rel)) {
+                        guarded([this]() { partition(); });
+                        continue;
+                    }
+                    if (partitioned.load(std::memory_order_acquire)) {
+                        bool sorted = false;
+                        guarded([&]() { sorted = sort_next_bucket(); });
+                        if (sorted) {
+                            continue;
+                        }
+                    }
+                    std::unique_lock<std::mutex> guard(lock);
+                    progress.wait(guard, [&]() {
+                        return ready.load(std::memory_order_acquire) > position || error ||
+                               (partitioned.load(std::memory_order_acquire) &&
+                                next_bucket.load(std::memory_order_relaxed) < buckets);
+                    });
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                }
+            }
+
+            /**
+             * @brief Number of leading positions that are final.
+             * @return The published prefix length.
+             */
+            size_t available() const {
+                return ready.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Element at a final position (see wait_for()).
+             * @param position The traversal position.
+             * @return Reference to the element.
+             */
+            const T& at(size_t position) const {
+                return (*data)[order[position]];
+            }
+        };
+    }
+
+    /**
+     * @brief Forward iterator over the container in ascending order that starts
+     * yielding before the whole sort is done.
+     *
+     * The first element is available after an O(n) partition pass and the
+     * sort of the lowest bucket; later buckets are sorted in the background
+     * (and by the iterator itself when it catches up). The sequence of values
+     * equals that of begin_ascending_order(); equal elements may appear in a
+     * different order. The stream reads an immutable copy-on-write snapshot,
+     * so the container may be modified while the iterator is in use.
+     *
+     * @tparam T The element type.
+     */
+    template<typename T>
+    class StreamingAscendingOrder {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+    private:
+        const MyContainer<T>* container = nullptr;
+        std::shared_ptr<detail::AscendingStream<T>> stream;
+        size_t current_index = 0;
+        size_t length = 0;
+
+    public:
+        /**
+         * @brief Singular iterator over no container, to be assigned before use.
+         */
+        StreamingAscendingOrder() = default;
+
+        /**
+         * @brief Constructor for the iterator.
+         * @param cont Reference to the container (used for comparisons).
+         * @param pos The starting position.
+         * @param size Number of positions in the stream.
+         * @param source The stream, or nullptr for an end iterator.
+         */
+        StreamingAscendingOrder(const MyContainer<T>& cont, size_t pos, size_t size,
+                                std::shared_ptr<detail::AscendingStream<T>> source = nullptr)
+            : container(&cont), stream(std::move(source)), current_index(pos), length(size) {}
+
+        /**
+         * @brief Access current element, waiting for its bucket if necessary.
+         * @return Reference to the current element.
+         * @throw std::out_of_range If out of bounds
+         */
+        const T& operator*() const {
+            if (current_index >= length || !stream) {
+                throw std::out_of_range("Iterator out of bounds");
+            }
+            stream->wait_for(current_index);
+            return stream->at(current_index);
+        }
+
+        /**
+         * @brief Member access to the current element.
+         * @return Pointer to the current element.
+         * @throw std::out_of_range If out of bounds
+         */
+        const T* operator->() const {
+            return &**this;
+        }
+
+        /**
+         * @brief Pre-increment operator. Advance to next position.
+         * @return Reference after increment.
+         * @throw std::out_of_range If incrementing past end
+         */
+        StreamingAscendingOrder& operator++() {
+            if (current_index >= length) {
+                throw std::out_of_range("Cannot increment iterator past end");
+            }
+            ++current_index;
+            return *this;
+        }
+
+        /**
+         * @brief Post-increment operator. Advance to next position.
+         * @return Copy of the iterator before increment.
+         * @throw std::out_of_range If incrementing past end
+         */
+        StreamingAscendingOrder operator++(int) {
+            StreamingAscendingOrder temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        /**
+         * @brief Returns the current traversal position.
+         * @return The position.
+         */
+        size_t position() const {
+            return current_index;
+        }
+
+        /**
+         * @brief Number of leading positions that can be read without waiting.
+         * @return The published prefix length.
+         */
+        size_t available() const {
+            return stream ? stream->available() : length;
+        }
+
+        /**
+         * @brief Equality operator. Every iterator that has run off its own
+         * stream equals the end, whatever the container's size is now, so a
+         * traversal ends after the snapshot's elements even if the container
+         * grew or shrank meanwhile.
+         * @param other The other iterator.
+         * @return True if both are at the same position of the same container, or both at its end.
+         */
+        bool operator==(const StreamingAscendingOrder& other) const {
+            if (container != other.container) {
+                return false;
+            }
+            bool at_end = current_index >= length;
+            bool other_at_end = other.current_index >= other.length;
+            return at_end || other_at_end ? at_end == other_at_end : current_index == other.current_index;
+        }
+
+        /**
+         * @brief Inequality operator.
+         * @param other The other iterator.
+         * @return True if the iterators differ.
+         */
+        bool operator!=(const StreamingAscendingOrder& other) const {
+            return !(*this == other);
+        }
+    };
+
+}
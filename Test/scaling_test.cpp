@@ -0,0 +1,202 @@
+// Complexity-regression tier: every operation and order is timed at n, 4n and
+// 16n, the growth exponent is fitted on a log-log scale, and the test fails
+// when it exceeds the documented complexity (e.g. an end_*() that is not O(1)
+// or a sorted traversal that is not O(n log n)). Run with `make scaling`.
+//
+// Exponent limits leave room for cache effects and timer noise while still
+// catching the next complexity class up: O(1) must stay below 0.4, O(n)
+// below 1.4 and O(n log n) below 1.5 (O(n^2) would fit 2).
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "../MyContainer.hpp"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace MyContainerNamespace;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+    const size_t base_size = size_t{1} << 14;
+    const size_t growth[] = {1, 4, 16};
+
+    const double constant_limit = 0.4;
+    const double linear_limit = 1.4;
+    const double linearithmic_limit = 1.5;
+
+    volatile long long sink = 0;
+
+    /**
+     * @brief Fresh container of n pseudo-random non-negative ints (no structure for the sort to exploit).
+     */
+    MyContainer<int> make_container(size_t n) {
+        std::vector<int> values(n);
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = static_cast<int>(detail::mix64(i) >> 33);
+        }
+        return MyContainer<int>(std::move(values));
+    }
+
+    /**
+     * @brief Per-call time of a cheap operation: repeated until a run takes a
+     * few milliseconds, best of five runs.
+     */
+    double time_per_call(const std::function<void()>& op) {
+        size_t calls = 1;
+        for (;;) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < calls; ++i) op();
+            if (Clock::now() - start >= std::chrono::milliseconds(5)) break;
+            calls *= 2;
+        }
+        double best = 1e300;
+        for (int run = 0; run < 5; ++run) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < calls; ++i) op();
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count() / calls);
+        }
+        return best;
+    }
+
+    /**
+     * @brief Per-call time of op with an untimed setup before every call, best of several runs.
+     */
+    double time_with_setup(const std::function<void()>& setup, const std::function<void()>& op) {
+        double best = 1e300;
+        for (int run = 0; run < 7; ++run) {
+            setup();
+            auto start = Clock::now();
+            op();
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+        return best;
+    }
+
+    /**
+     * @brief Least-squares slope of log(time) over log(n) for sizes n, 4n and 16n.
+     * @param measure Returns the time of one operation on a container of the given size.
+     */
+    double growth_exponent(const std::function<double(size_t)>& measure) {
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (size_t factor : growth) {
+            double x = std::log(static_cast<double>(base_size * factor));
+            double y = std::log(measure(base_size * factor));
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        double k = static_cast<double>(std::size(growth));
+        return (k * sxy - sx * sy) / (k * sxx - sx * sx);
+    }
+
+    void check_exponent(const std::string& name, double limit, const std::function<double(size_t)>& measure) {
+        double exponent = growth_exponent(measure);
+        INFO(name << ": fitted exponent " << exponent << ", limit " << limit);
+        CHECK(exponent < limit);
+    }
+
+    /**
+     * @brief Checks begin (cold and warm), end and full traversal of one order.
+     * begin is timed without dereferencing: the cost of reaching an element
+     * (e.g. the random order's cycle walk) varies by position and is covered
+     * by the traversal, which must stay O(n) overall.
+     * @param sorted Whether the cold begin sorts (O(n log n)) rather than being O(1).
+     */
+    template<typename Begin, typename End>
+    void check_order(const std::string& name, bool sorted, Begin begin, End end) {
+        check_exponent(name + " end", constant_limit, [&](size_t n) {
+            MyContainer<int> c = make_container(n);
+            return time_per_call([&]() { sink = sink + static_cast<long long>(end(c).position()); });
+        });
+        check_exponent(name + " begin (cold)", sorted ? linearithmic_limit : constant_limit, [&](size_t n) {
+            MyContainer<int> c = make_container(n);
+            if (!sorted) {
+                return time_per_call([&]() { sink = sink + static_cast<long long>(begin(c).position()); });
+            }
+            // add() invalidates the cached permutation, so every begin rebuilds it.
+            return time_with_setup([&]() { c.add(0); }, [&]() { sink = sink + static_cast<long long>(begin(c).position()); });
+        });
+        check_exponent(name + " begin (warm)", constant_limit, [&](size_t n) {
+            MyContainer<int> c = make_container(n);
+            sink = sink + *begin(c);
+            return time_per_call([&]() { sink = sink + static_cast<long long>(begin(c).position()); });
+        });
+        check_exponent(name + " traversal", linear_limit, [&](size_t n) {
+            MyContainer<int> c = make_container(n);
+            sink = sink + *begin(c);
+            return time_per_call([&]() {
+                long long total = 0;
+                for (auto it = begin(c), last = end(c); it != last; ++it) total += *it;
+                sink = sink + total;
+            });
+        });
+    }
+
+}
+
+TEST_CASE("Scaling of element operations") {
+    check_exponent("add", constant_limit, [](size_t n) {
+        MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { c.add(1); });
+    });
+    check_exponent("operator[]", constant_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        size_t i = 0;
+        return time_per_call([&]() { sink = sink + c[i]; i = (i + 7919) % n; });
+    });
+    check_exponent("remove", linear_limit, [](size_t n) {
+        MyContainer<int> c = make_container(n);
+        // The removed value sits at the end, so remove scans the whole container.
+        return time_with_setup([&]() { c.add(-1); }, [&]() { c.remove(-1); });
+    });
+    check_exponent("contains (absent)", linear_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { sink = sink + c.contains(-1); });
+    });
+    check_exponent("contains (absent, filtered)", constant_limit, [](size_t n) {
+        MyContainer<int> c = make_container(n);
+        c.enable_membership_filter();
+        return time_per_call([&]() { sink = sink + c.contains(-1 - static_cast<int>(sink & 1023)); });
+    });
+    check_exponent("sum", linear_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { sink = sink + c.sum(); });
+    });
+    check_exponent("size", constant_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { sink = sink + static_cast<long long>(c.size()); });
+    });
+}
+
+TEST_CASE("Scaling of copies") {
+    check_exponent("copy", constant_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { MyContainer<int> copy = c; sink = sink + static_cast<long long>(copy.size()); });
+    });
+    check_exponent("copy and first write", linear_limit, [](size_t n) {
+        const MyContainer<int> c = make_container(n);
+        return time_per_call([&]() { MyContainer<int> copy = c; copy.add(1); });
+    });
+}
+
+TEST_CASE("Scaling of every order") {
+    check_order("insertion", false,
+        [](const MyContainer<int>& c) { return c.begin_order(); }, [](const MyContainer<int>& c) { return c.end_order(); });
+    check_order("reverse", false,
+        [](const MyContainer<int>& c) { return c.begin_reverse_order(); }, [](const MyContainer<int>& c) { return c.end_reverse_order(); });
+    check_order("middle-out", false,
+        [](const MyContainer<int>& c) { return c.begin_middle_out_order(); }, [](const MyContainer<int>& c) { return c.end_middle_out_order(); });
+    check_order("random", false,
+        [](const MyContainer<int>& c) { return c.begin_random_order(7); }, [](const MyContainer<int>& c) { return c.end_random_order(7); });
+    check_order("ascending", true,
+        [](const MyContainer<int>& c) { return c.begin_ascending_order(); }, [](const MyContainer<int>& c) { return c.end_ascending_order(); });
+    check_order("descending", true,
+        [](const MyContainer<int>& c) { return c.begin_descending_order(); }, [](const MyContainer<int>& c) { return c.end_descending_order(); });
+    check_order("side-cross", true,
+        [](const MyContainer<int>& c) { return c.begin_side_cross_order(); }, [](const MyContainer<int>& c) { return c.end_side_cross_order(); });
+}
@@ -1,6 +1,17 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#define MYCONTAINER_ALLOCATION_TRACKER_IMPLEMENTATION
+#include "../AllocationTracker.hpp"
 #include "../MyContainer.hpp"
+#include "../ConcurrentMyContainer.hpp"
+#include "../SnapshotContainer.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <atomic>
 
 using namespace MyContainerNamespace;
 
@@ -265,4 +276,1123 @@ TEST_CASE("MiddleOutOrder iterator - string") {
         result.push_back(*it);
     }
     CHECK(result == expected);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Iterators support random access") {
+    MyContainer<int> c;
+    c.add(5); c.add(1); c.add(3); c.add(2); c.add(4);
+    auto begin = c.begin_ascending_order();
+    auto end = c.end_ascending_order();
+    CHECK(end - begin == 5);
+    CHECK(begin[2] == 3);
+    CHECK(*(begin + 4) == 5);
+    CHECK(*(end - 1) == 5);
+    CHECK(begin < end);
+    CHECK(std::is_sorted(begin, end));
+    auto it = end;
+    --it;
+    CHECK(*it == 5);
+    CHECK_THROWS_AS(begin - 1, std::out_of_range);
+    CHECK_THROWS_AS(begin + 6, std::out_of_range);
+    CHECK_THROWS_AS(--begin, std::out_of_range);
+}
+
+TEST_CASE("Iterators are default-constructible") {
+    static_assert(std::is_default_constructible_v<AscendingOrder<int>>);
+    static_assert(std::is_default_constructible_v<OrderedIterator<int, RandomMapping>>);
+    static_assert(std::is_default_constructible_v<StreamingAscendingOrder<int>>);
+    MyContainer<int> c(std::vector<int>{3, 1, 2});
+    AscendingOrder<int> it;
+    CHECK(it == AscendingOrder<int>());
+    it = c.begin_ascending_order();
+    CHECK(*it == 1);
+    std::vector<AscendingOrder<int>> positions(3);
+    for (auto& position : positions) {
+        position = it++;
+    }
+    CHECK(*positions[2] == 3);
+    CHECK(std::is_sorted(positions.front(), c.end_ascending_order()));
+}
+
+TEST_CASE("MiddleOutOrder closed form matches reference walk") {
+    for (size_t n = 1; n <= 20; ++n) {
+        MyContainer<int> c;
+        for (size_t i = 0; i < n; ++i) {
+            c.add(static_cast<int>(i));
+        }
+        std::vector<int> expected;
+        size_t middle = n / 2;
+        expected.push_back(static_cast<int>(middle));
+        for (size_t d = 1; expected.size() < n; ++d) {
+            if (d <= middle) expected.push_back(static_cast<int>(middle - d));
+            if (middle + d < n) expected.push_back(static_cast<int>(middle + d));
+        }
+        std::vector<int> result(c.begin_middle_out_order(), c.end_middle_out_order());
+        CHECK(result == expected);
+    }
+}
+
+static int reverse_builds = 0;
+
+TEST_CASE("Custom orders - closed form and permutation") {
+    MyContainer<int> c;
+    for (int i = 0; i < 7; ++i) c.add(i * 10);
+
+    auto stride = make_index_order([](size_t k, size_t n) { return (k * 3) % n; });
+    std::vector<int> strided(c.begin_custom_order(stride), c.end_custom_order(stride));
+    CHECK(strided == std::vector<int>{0, 30, 60, 20, 50, 10, 40});
+
+    auto reversed = make_permutation_order([](const std::vector<int>& data, std::vector<size_t>& indices) {
+        ++reverse_builds;
+        indices.resize(data.size());
+        for (size_t i = 0; i < data.size(); ++i) indices[i] = data.size() - 1 - i;
+    });
+    reverse_builds = 0;
+    auto it = c.begin_custom_order(reversed);
+    auto it2 = c.begin_custom_order(reversed);
+    CHECK(reverse_builds == 1);
+    CHECK(*it == 60);
+    CHECK(c.end_custom_order(reversed) - it2 == 7);
+    CHECK(reverse_builds == 1);
+    c.add(70);
+    CHECK(*c.begin_custom_order(reversed) == 70);
+    CHECK(reverse_builds == 2);
+    CHECK(*it == 60);
+}
+
+TEST_CASE("Orders see writes made through a held getData() reference") {
+    MyContainer<int> c(std::vector<int>{30, 10, 20});
+    std::vector<int>& data = c.getData();
+    CHECK(*c.begin_ascending_order() == 10);
+
+    data[1] = 40;
+    data.push_back(5);
+    data.push_back(25);
+    std::vector<int> ascending(c.begin_ascending_order(), c.end_ascending_order());
+    CHECK(ascending == std::vector<int>{5, 20, 25, 30, 40});
+
+    // An iterator built before the growth rebuilds rather than reading past its permutation.
+    auto it = c.begin_descending_order();
+    data.push_back(1);
+    CHECK(*(it + 5) == 1);
+    std::vector<int> descending(c.begin_descending_order(), c.end_descending_order());
+    CHECK(descending == std::vector<int>{40, 30, 25, 20, 5, 1});
+}
+
+TEST_CASE("Non-const element access keeps orders and the filter cached") {
+    MyContainer<int> c(std::vector<int>{30, 10, 20});
+    c.enable_membership_filter();
+    CHECK(c[0] == 30);
+    auto cached = c.permutation_for(AscendingMapping());
+    CHECK(*c.begin_ascending_order() == 10);
+    CHECK(c.permutation_for(AscendingMapping()) == cached);
+
+    c[0] = 5;
+    CHECK(*c.begin_ascending_order() == 5);
+    auto rebuilt = c.permutation_for(AscendingMapping());
+    CHECK(rebuilt != cached);
+    CHECK(c.permutation_for(AscendingMapping()) == rebuilt);
+
+    CHECK(c.getData().size() == 3);
+    CHECK(c.contains(5));
+    size_t rebuilds = c.filter_stats().rebuilds;
+    CHECK_FALSE(c.contains(30));
+    CHECK_FALSE(c.contains(777));
+    CHECK(c.filter_stats().rebuilds == rebuilds);
+    CHECK(c.filter_stats().rejected >= 1);
+}
+
+TEST_CASE("Custom orders - invalid mappings throw") {
+    MyContainer<int> c;
+    c.add(1); c.add(2);
+    auto bad_index = make_index_order([](size_t k, size_t n) { return k + n; });
+    CHECK_THROWS_AS(*c.begin_custom_order(bad_index), std::out_of_range);
+    auto short_perm = make_permutation_order([](const std::vector<int>&, std::vector<size_t>& indices) {
+        indices = {0};
+    });
+    CHECK_THROWS_AS(c.begin_custom_order(short_perm), std::invalid_argument);
+    auto past_end = make_permutation_order([](const std::vector<int>& data, std::vector<size_t>& indices) {
+        indices = {0, data.size()};
+    });
+    CHECK_THROWS_AS(*c.begin_custom_order(past_end), std::invalid_argument);
+    CHECK_THROWS_AS(c.to_vector(past_end), std::invalid_argument);
+    auto repeated = make_permutation_order([](const std::vector<int>&, std::vector<size_t>& indices) {
+        indices = {1, 1};
+    });
+    CHECK_THROWS_AS(c.to_vector(repeated), std::invalid_argument);
+    auto swapped = make_permutation_order([](const std::vector<int>&, std::vector<size_t>& indices) {
+        indices = {1, 0};
+    });
+    CHECK(c.to_vector(swapped) == std::vector<int>{2, 1});
+}
+
+TEST_CASE("RandomOrder visits every element exactly once") {
+    for (int n = 1; n <= 70; ++n) {
+        MyContainer<int> c;
+        for (int i = 0; i < n; ++i) c.add(i);
+        std::vector<int> result(c.begin_random_order(42), c.end_random_order(42));
+        REQUIRE(result.size() == static_cast<size_t>(n));
+        std::vector<int> sorted = result;
+        std::sort(sorted.begin(), sorted.end());
+        for (int i = 0; i < n; ++i) {
+            CHECK(sorted[i] == i);
+        }
+    }
+}
+
+TEST_CASE("RandomOrder is deterministic per seed") {
+    MyContainer<int> c;
+    for (int i = 0; i < 100; ++i) c.add(i);
+    std::vector<int> a(c.begin_random_order(7), c.end_random_order(7));
+    std::vector<int> b(c.begin_random_order(7), c.end_random_order(7));
+    std::vector<int> other(c.begin_random_order(8), c.end_random_order(8));
+    CHECK(a == b);
+    CHECK(a != other);
+    CHECK(c.begin_random_order(7)[57] == a[57]);
+    MyContainer<int> empty;
+    CHECK(empty.begin_random_order(1) == empty.end_random_order(1));
+}
+
+TEST_CASE("Block iteration over contiguous orders") {
+    MyContainer<int> c;
+    for (int i = 0; i < 10; ++i) c.add(i);
+    std::vector<size_t> sizes;
+    std::vector<int> forward, backward;
+    c.for_each_block(InsertionMapping(), 4, [&](Span<const int> block) {
+        sizes.push_back(block.size());
+        forward.insert(forward.end(), block.begin(), block.end());
+    });
+    CHECK(sizes == std::vector<size_t>{4, 4, 2});
+    CHECK(forward == std::vector<int>(c.begin_order(), c.end_order()));
+    c.for_each_block(ReverseMapping(), 4, [&](Span<const int> block) {
+        backward.insert(backward.end(), block.rbegin(), block.rend());
+    });
+    CHECK(backward == std::vector<int>(c.begin_reverse_order(), c.end_reverse_order()));
+    CHECK_THROWS_AS(c.for_each_block(InsertionMapping(), 0, [](Span<const int>) {}), std::invalid_argument);
+}
+
+TEST_CASE("Gathered block iteration over permuted orders") {
+    MyContainer<int> c;
+    c.add(5); c.add(1); c.add(3); c.add(2); c.add(4);
+    int buffer[2];
+    std::vector<int> asc, middle;
+    c.for_each_gathered_block(AscendingMapping(), buffer, 2, [&](Span<const int> block) {
+        CHECK(block.size() <= 2);
+        asc.insert(asc.end(), block.begin(), block.end());
+    });
+    CHECK(asc == std::vector<int>{1, 2, 3, 4, 5});
+    c.for_each_gathered_block(MiddleOutMapping(), buffer, 2, [&](Span<const int> block) {
+        middle.insert(middle.end(), block.begin(), block.end());
+    });
+    CHECK(middle == std::vector<int>(c.begin_middle_out_order(), c.end_middle_out_order()));
+}
+
+TEST_CASE("materialize and to_vector match iteration for every order") {
+    MyContainer<double> d;
+    MyContainer<int> c;
+    for (int i = 0; i < 37; ++i) {
+        c.add((i * 17) % 37 - 5);
+        d.add(((i * 11) % 37) * 0.5);
+    }
+    for (auto level : {detail::SimdLevel::Scalar, detail::SimdLevel::AVX2, detail::SimdLevel::AVX512}) {
+        detail::limit_simd_level(level);
+        CHECK(c.to_vector(AscendingMapping()) == std::vector<int>(c.begin_ascending_order(), c.end_ascending_order()));
+        CHECK(c.to_vector(SideCrossMapping()) == std::vector<int>(c.begin_side_cross_order(), c.end_side_cross_order()));
+        CHECK(d.to_vector(DescendingMapping()) == std::vector<double>(d.begin_descending_order(), d.end_descending_order()));
+    }
+    detail::limit_simd_level(detail::SimdLevel::AVX512);
+    CHECK(c.to_vector(InsertionMapping()) == std::vector<int>(c.begin_order(), c.end_order()));
+    CHECK(c.to_vector(ReverseMapping()) == std::vector<int>(c.begin_reverse_order(), c.end_reverse_order()));
+    CHECK(c.to_vector(MiddleOutMapping()) == std::vector<int>(c.begin_middle_out_order(), c.end_middle_out_order()));
+    CHECK(c.to_vector(RandomMapping(3)) == std::vector<int>(c.begin_random_order(3), c.end_random_order(3)));
+
+    MyContainer<std::string> s;
+    s.add("b"); s.add("c"); s.add("a");
+    std::vector<std::string> out(3);
+    s.materialize(AscendingMapping(), out.data());
+    CHECK(out == std::vector<std::string>{"a", "b", "c"});
+}
+
+TEST_CASE("materialize above the parallel threshold") {
+    MyContainer<int> c;
+    size_t n = detail::parallel_threshold + 1234;
+    c.getData().reserve(n);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<int>(n - i));
+    std::vector<int> asc = c.to_vector(AscendingMapping());
+    CHECK(asc.size() == n);
+    CHECK(std::is_sorted(asc.begin(), asc.end()));
+    std::vector<int> rev = c.to_vector(ReverseMapping());
+    CHECK(rev.front() == 1);
+    CHECK(rev.back() == static_cast<int>(n));
+}
+
+TEST_CASE("Reductions - int") {
+    MyContainer<int> c;
+    for (int i = 0; i < 1003; ++i) c.add((i * 37) % 101 - 50);
+    long long expected_sum = 0;
+    size_t expected_count = 0;
+    for (int v : c.getData()) {
+        expected_sum += v;
+        expected_count += (v == 7) ? 1 : 0;
+    }
+    for (auto level : {detail::SimdLevel::Scalar, detail::SimdLevel::SSE2, detail::SimdLevel::AVX2, detail::SimdLevel::AVX512}) {
+        detail::limit_simd_level(level);
+        CHECK(c.sum() == expected_sum);
+        CHECK(c.min() == -50);
+        CHECK(c.max() == 50);
+        CHECK(c.minmax() == std::make_pair(-50, 50));
+        CHECK(c.count(7) == expected_count);
+        CHECK(c.count(1000) == 0);
+    }
+    detail::limit_simd_level(detail::SimdLevel::AVX512);
+    CHECK(c.mean() == doctest::Approx(static_cast<double>(expected_sum) / 1003));
+}
+
+TEST_CASE("Reductions - double and deterministic summation") {
+    MyContainer<double> c;
+    for (int i = 0; i < 20011; ++i) c.add(1.0 / (i + 1) * ((i % 3 == 0) ? -1e6 : 1.0));
+    double reference = c.sum(Summation::Deterministic);
+    for (auto level : {detail::SimdLevel::Scalar, detail::SimdLevel::SSE2, detail::SimdLevel::AVX2, detail::SimdLevel::AVX512}) {
+        detail::limit_simd_level(level);
+        CHECK(c.sum(Summation::Deterministic) == reference);
+        CHECK(c.sum() == doctest::Approx(reference));
+        CHECK(c.min() == -1e6);
+        CHECK(c.count(0.5) == 1);
+    }
+    detail::limit_simd_level(detail::SimdLevel::AVX512);
+
+    MyContainer<double> empty;
+    CHECK(empty.sum() == 0.0);
+    CHECK_THROWS_AS(empty.min(), std::out_of_range);
+    CHECK_THROWS_AS(empty.mean(), std::out_of_range);
+}
+
+TEST_CASE("Reductions - NaN propagates through min and max on every tier") {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (auto level : {detail::SimdLevel::Scalar, detail::SimdLevel::SSE2, detail::SimdLevel::AVX2, detail::SimdLevel::AVX512}) {
+        detail::limit_simd_level(level);
+        // NaN first, inside the vector body at every lane offset, and in the scalar tail.
+        for (size_t n : {5u, 37u, 300000u}) {
+            for (size_t at : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{7}, n / 2, n - 1}) {
+                if (at >= n) continue;
+                std::vector<double> values(n);
+                for (size_t i = 0; i < n; ++i) values[i] = static_cast<double>(i % 101) - 50.0;
+                values[at] = nan;
+                MyContainer<double> c(std::move(values));
+                INFO("n = " << n << ", NaN at " << at);
+                CHECK(std::isnan(c.min()));
+                CHECK(std::isnan(c.max()));
+            }
+        }
+        std::vector<float> floats(64, 1.0f);
+        floats[13] = std::numeric_limits<float>::quiet_NaN();
+        MyContainer<float> f(std::move(floats));
+        CHECK(std::isnan(f.minmax().first));
+        CHECK(std::isnan(f.minmax().second));
+        MyContainer<double> clean(std::vector<double>{3.0, -0.0, 2.5});
+        CHECK(clean.minmax() == std::make_pair(-0.0, 3.0));
+    }
+    detail::limit_simd_level(detail::SimdLevel::AVX512);
+}
+
+TEST_CASE("Reductions - non-arithmetic minmax and count") {
+    MyContainer<std::string> c;
+    c.add("pear"); c.add("apple"); c.add("zucchini"); c.add("apple");
+    CHECK(c.min() == "apple");
+    CHECK(c.max() == "zucchini");
+    CHECK(c.count("apple") == 2);
+}
+
+TEST_CASE("Vectorized contains and remove match the scalar algorithms") {
+    for (auto level : {detail::SimdLevel::Scalar, detail::SimdLevel::AVX2, detail::SimdLevel::AVX512}) {
+        detail::limit_simd_level(level);
+        for (size_t n : {1u, 7u, 8u, 33u, 100u, 257u}) {
+            MyContainer<int> c;
+            std::vector<int> expected;
+            for (size_t i = 0; i < n; ++i) {
+                int v = static_cast<int>((i * 7) % 5);
+                c.add(v);
+                if (v != 3) expected.push_back(v);
+            }
+            CHECK(c.contains(0));
+            CHECK_FALSE(c.contains(9));
+            if (n > 3) {
+                c.remove(3);
+                CHECK(c.getData() == expected);
+                CHECK_FALSE(c.contains(3));
+            }
+            CHECK_THROWS_AS(c.remove(9), std::invalid_argument);
+        }
+
+        MyContainer<double> d;
+        for (int i = 0; i < 40; ++i) d.add((i % 4 == 1) ? -0.0 : i * 1.5);
+        d.add(std::numeric_limits<double>::quiet_NaN());
+        CHECK(d.contains(0.0));
+        CHECK_FALSE(d.contains(std::numeric_limits<double>::quiet_NaN()));
+        d.remove(0.0);
+        CHECK(d.size() == 30);
+        CHECK(d.count(0.0) == 0);
+
+        MyContainer<long long> big;
+        for (long long i = 0; i < 50; ++i) big.add(i % 2 == 0 ? 1LL << 40 : i);
+        big.remove(1LL << 40);
+        CHECK(big.size() == 25);
+        CHECK(big[0] == 1);
+        CHECK(big[24] == 49);
+    }
+    detail::limit_simd_level(detail::SimdLevel::AVX512);
+}
+
+TEST_CASE("Membership filter rejects misses without scanning") {
+    MyContainer<int> c;
+    for (int i = 0; i < 5000; ++i) c.add(i * 2);
+    c.enable_membership_filter(0.01);
+    for (int i = 5000; i < 6000; ++i) c.add(i * 2);
+
+    size_t misses = 0;
+    for (int i = 0; i < 6000; ++i) {
+        CHECK(c.contains(i * 2));
+        CHECK_THROWS_AS(c.remove(i * 2 + 1), std::invalid_argument);
+        ++misses;
+    }
+    MembershipFilterStats stats = c.filter_stats();
+    CHECK(stats.enabled);
+    CHECK(stats.memory_bytes > 0);
+    CHECK(stats.queries == 12000);
+    CHECK(stats.rejected + stats.false_positives == misses);
+    CHECK(stats.false_positives < misses / 20);
+    CHECK(stats.estimated_false_positive_rate < 0.05);
+
+    c.remove(10);
+    CHECK_FALSE(c.contains(10));
+    c[0] = 12345;
+    CHECK(c.contains(12345));
+    CHECK(c.filter_stats().rebuilds >= 2);
+
+    MyContainer<int> copy = c;
+    CHECK(copy.contains(12345));
+    c.disable_membership_filter();
+    CHECK_FALSE(c.filter_stats().enabled);
+    CHECK(c.contains(12345));
+    CHECK_THROWS_AS(c.enable_membership_filter(1.5), std::invalid_argument);
+}
+
+TEST_CASE("Membership filter never misses writes through a held reference") {
+    MyContainer<int> c(std::vector<int>{1, 2, 3});
+    c.enable_membership_filter();
+    std::vector<int>& data = c.getData();
+    CHECK(c.contains(2));
+    CHECK_FALSE(c.contains(777));
+
+    data.push_back(777);
+    data[0] = 888;
+    CHECK(c.contains(777));
+    CHECK(c.contains(888));
+    CHECK_NOTHROW(c.remove(777));
+    CHECK_FALSE(c.contains(777));
+
+    // A copy takes the current data, so its filter is rebuilt from it.
+    data.push_back(999);
+    MyContainer<int> copy = c;
+    CHECK(copy.contains(999));
+    CHECK(copy.contains(888));
+    CHECK_FALSE(copy.contains(1));
+}
+
+TEST_CASE("Membership filter - concurrent const contains") {
+    MyContainer<int> c;
+    for (int i = 0; i < 20000; ++i) c.add(2 * i);
+    c.enable_membership_filter();
+    c[0] = 1;  // the next lookup rebuilds the filter, from whichever thread gets there first
+    const MyContainer<int>& view = c;
+    const int threads = 4;
+    const int lookups = 2000;
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < threads; ++t) {
+        readers.emplace_back([&view, &wrong, t]() {
+            for (int i = 0; i < lookups; ++i) {
+                int value = (t * lookups + i) % 40000;
+                bool expected = value == 1 || (value != 0 && value % 2 == 0);
+                if (view.contains(value) != expected) ++wrong;
+                if (i % 500 == 0 && !view.filter_stats().enabled) ++wrong;
+            }
+        });
+    }
+    for (auto& t : readers) t.join();
+    CHECK(wrong == 0);
+    MembershipFilterStats stats = view.filter_stats();
+    CHECK(stats.queries == static_cast<size_t>(threads * lookups));
+    CHECK(stats.rebuilds == 2);
+    CHECK(stats.rejected + stats.false_positives == static_cast<size_t>(threads * lookups) / 2);
+}
+
+TEST_CASE("Membership filter on strings") {
+    MyContainer<std::string> c;
+    c.enable_membership_filter();
+    c.add("alpha"); c.add("beta");
+    CHECK(c.contains("alpha"));
+    CHECK_FALSE(c.contains("gamma"));
+    c.remove("alpha");
+    CHECK_FALSE(c.contains("alpha"));
+}
+
+TEST_CASE("ConcurrentMyContainer - concurrent producers then freeze") {
+    ConcurrentMyContainer<int> ingest(4);
+    const int producers = 8;
+    const int per_producer = 5000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ingest, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                ingest.add(p * per_producer + i);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    CHECK(ingest.size() == producers * per_producer);
+
+    MyContainer<int> sealed = ingest.freeze();
+    CHECK(ingest.size() == 0);
+    CHECK(sealed.size() == producers * per_producer);
+    std::vector<int> asc = sealed.to_vector(AscendingMapping());
+    for (int i = 0; i < producers * per_producer; ++i) {
+        CHECK(asc[i] == i);
+    }
+    CHECK(*sealed.begin_descending_order() == producers * per_producer - 1);
+}
+
+TEST_CASE("ConcurrentMyContainer - non-trivial elements are destroyed") {
+    ConcurrentMyContainer<std::string> ingest(2);
+    for (int i = 0; i < 3000; ++i) ingest.add(std::string(40, static_cast<char>('a' + i % 26)));
+    MyContainer<std::string> sealed = ingest.freeze();
+    CHECK(sealed.size() == 3000);
+    ingest.add("left over");
+}
+
+TEST_CASE("MpscQueue - bounded FIFO and batch drain into a container") {
+    CHECK_THROWS_AS(MpscQueue<int>(0), std::invalid_argument);
+    MpscQueue<int> queue(3);
+    CHECK(queue.capacity() == 4);
+    for (int i = 0; i < 4; ++i) CHECK(queue.try_push(i));
+    CHECK_FALSE(queue.try_push(99));
+    int out = -1;
+    CHECK(queue.try_pop(out));
+    CHECK(out == 0);
+    CHECK(queue.try_push(4));
+
+    MyContainer<int> c;
+    c.enable_membership_filter();
+    CHECK(c.empty());
+    CHECK(c.drain(queue, 2) == 2);
+    CHECK(c.drain(queue) == 2);
+    CHECK(c.drain(queue) == 0);
+    CHECK(c.to_vector(InsertionMapping()) == std::vector<int>{1, 2, 3, 4});
+    CHECK(*c.begin_ascending_order() == 1);
+    CHECK(c.contains(4));
+
+    std::vector<int> more{7, 5};
+    c.add_range(more.begin(), more.end());
+    CHECK(c.size() == 6);
+    CHECK(c.contains(7));
+    CHECK(*c.begin_descending_order() == 7);
+
+    // Many small drains must keep the vector's geometric growth.
+    MyContainer<int> drained;
+    const std::vector<int>& data = static_cast<const MyContainer<int>&>(drained).getData();
+    size_t reallocations = 0;
+    for (int i = 0; i < 10000; ++i) {
+        size_t capacity = data.capacity();
+        queue.try_push(i);
+        drained.drain(queue);
+        reallocations += data.capacity() != capacity;
+    }
+    CHECK(drained.size() == 10000);
+    CHECK(reallocations <= 20);
+}
+
+TEST_CASE("MpscQueue - concurrent producers with one consumer") {
+    MpscQueue<int> queue(64);
+    const int producers = 4;
+    const int per_producer = 5000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+    MyContainer<int> c;
+    while (c.size() < static_cast<size_t>(producers * per_producer)) {
+        if (c.drain(queue, 128) == 0) std::this_thread::yield();
+    }
+    for (auto& t : threads) t.join();
+    std::vector<int> asc = c.to_vector(AscendingMapping());
+    for (int i = 0; i < producers * per_producer; ++i) {
+        CHECK(asc[i] == i);
+    }
+    MpscQueue<std::string> strings(8);
+    strings.push(std::string(40, 'x'));
+}
+
+TEST_CASE("SnapshotContainer - snapshots are immutable versions") {
+    SnapshotContainer<int> c;
+    CHECK(c.snapshot()->empty());
+    c.add(3);
+    c.add(1);
+    CHECK(c.snapshot()->empty());
+    CHECK(c.publish() == 1);
+    auto first = c.snapshot();
+    auto it = first->begin_ascending_order();
+    c.add(0);
+    c.remove(3);
+    c.publish();
+    CHECK(*it == 1);
+    ++it;
+    CHECK(*it == 3);
+    CHECK(first->size() == 2);
+    CHECK(c.snapshot()->to_vector(InsertionMapping()) == std::vector<int>{1, 0});
+    CHECK(c.version() == 2);
+    CHECK_THROWS_AS(c.remove(42), std::invalid_argument);
+}
+
+TEST_CASE("SnapshotContainer - readers traverse while a writer publishes") {
+    SnapshotContainer<int> c;
+    const int rounds = 200;
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                auto snap = c.snapshot();
+                size_t seen = 0;
+                int previous = -1;
+                for (auto it = snap->begin_ascending_order(); it != snap->end_ascending_order(); ++it, ++seen) {
+                    if (*it <= previous) ++bad;
+                    previous = *it;
+                }
+                if (seen != snap->size()) ++bad;
+            }
+        });
+    }
+    for (int i = 0; i < rounds; ++i) {
+        c.update([i](MyContainer<int>& working) {
+            for (int k = 0; k < 50; ++k) working.add(i * 50 + k);
+        });
+        c.publish();
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+    CHECK(bad == 0);
+    CHECK(c.snapshot()->size() == rounds * 50);
+}
+
+TEST_CASE("Copy-on-write sharing between copies") {
+    MyContainer<int> original(std::vector<int>{5, 2, 8});
+    auto cached = original.permutation_for(AscendingMapping());
+    MyContainer<int> copy = original;
+    const MyContainer<int>& view = copy;
+    CHECK(&view.getData() == &static_cast<const MyContainer<int>&>(original).getData());
+    CHECK(copy.permutation_for(AscendingMapping()) == cached);
+
+    copy.add(1);
+    CHECK(original.size() == 3);
+    CHECK(copy.size() == 4);
+    CHECK(*original.begin_ascending_order() == 2);
+    CHECK(*copy.begin_ascending_order() == 1);
+    CHECK(original.permutation_for(AscendingMapping()) == cached);
+
+    MyContainer<int> assigned;
+    assigned = original;
+    assigned.remove(5);
+    CHECK(original.to_vector(InsertionMapping()) == std::vector<int>{5, 2, 8});
+    CHECK(assigned.to_vector(InsertionMapping()) == std::vector<int>{2, 8});
+
+    // Once a mutable reference escapes, copies no longer share the buffer.
+    int& first = original[0];
+    MyContainer<int> late = original;
+    first = 7;
+    CHECK(late[0] == 5);
+    CHECK(original[0] == 7);
+}
+
+TEST_CASE("ThreadPool - submit, fork/join chunks and exceptions") {
+    ThreadPool pool(3);
+    CHECK(pool.size() == 3);
+    auto answer = pool.submit([]() { return 42; });
+    CHECK(answer.get() == 42);
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    CHECK_THROWS_AS(failing.get(), std::runtime_error);
+
+    std::vector<int> hits(100, 0);
+    pool.run_chunks(hits.size(), [&](size_t c) { hits[c] += 1; });
+    CHECK(std::count(hits.begin(), hits.end(), 1) == 100);
+
+    std::atomic<int> nested{0};
+    pool.run_chunks(4, [&](size_t) {
+        pool.run_chunks(8, [&](size_t) { ++nested; });
+    });
+    CHECK(nested == 32);
+
+    CHECK_THROWS_AS(pool.run_chunks(10, [](size_t c) {
+        if (c == 7) throw std::out_of_range("chunk failed");
+    }), std::out_of_range);
+}
+
+TEST_CASE("parallel_for_each and parallel_transform over every order") {
+    MyContainer<int> c;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) c.add((i * 7919) % n);
+    ThreadPool pool(3);
+
+    auto check_order = [&](const auto& policy) {
+        std::vector<int> expected = c.to_vector(policy);
+        for (ThreadPool* p : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            std::vector<long long> doubled(c.size());
+            c.parallel_transform(policy, doubled.data(), [](int v) { return 2LL * v; }, p);
+            bool same = true;
+            for (size_t k = 0; k < expected.size(); ++k) same = same && doubled[k] == 2LL * expected[k];
+            CHECK(same);
+
+            std::atomic<long long> total{0};
+            c.parallel_for_each(policy, [&](int v) { total += v; }, p);
+            CHECK(total == c.sum());
+        }
+    };
+    check_order(InsertionMapping());
+    check_order(ReverseMapping());
+    check_order(AscendingMapping());
+    check_order(SideCrossMapping());
+    check_order(MiddleOutMapping());
+    check_order(RandomMapping(3));
+
+    std::vector<int> serial;
+    c.parallel_for_each(DescendingMapping(), [&](int v) { serial.push_back(v); }, nullptr);
+    CHECK(serial == c.to_vector(DescendingMapping()));
+
+    std::vector<int> out(c.size());
+    c.parallel_transform(AscendingMapping(), out.data(), [](int v) { return v; });
+    CHECK(out == c.to_vector(AscendingMapping()));
+}
+
+TEST_CASE("prepare_async builds orders in the background") {
+    ThreadPool pool(2);
+    MyContainer<int> c(std::vector<int>{4, 9, 1, 7});
+    PermutationFuture ascending = c.prepare_async(AscendingMapping(), pool);
+    PermutationFuture side_cross = c.prepare_async(SideCrossMapping(), pool);
+    CHECK(c.prepare_async(MiddleOutMapping(), pool).get() == nullptr);
+    CHECK(*c.begin_ascending_order() == 1);
+    CHECK(ascending.get() == c.permutation_for(AscendingMapping()));
+    side_cross.wait();
+    std::vector<int> expected_side_cross{1, 9, 4, 7};
+    CHECK(c.to_vector(SideCrossMapping()) == expected_side_cross);
+
+    // Mutating while a build is pending leaves the build on the old buffer.
+    PermutationFuture descending = c.prepare_async(DescendingMapping(), pool);
+    c.add(100);
+    CHECK(descending.get()->size() == 4);
+    CHECK(*c.begin_descending_order() == 100);
+
+    auto failing = make_permutation_order([](const std::vector<int>&, std::vector<size_t>& out) {
+        out.assign(1, 0);
+    });
+    CHECK_THROWS_AS(c.prepare_async(failing, pool).get(), std::invalid_argument);
+    CHECK_THROWS_AS(c.begin_custom_order(failing), std::invalid_argument);
+}
+
+TEST_CASE("prepare_async on a pool whose only worker is busy") {
+    ThreadPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    auto blocker = pool.submit([gate]() { gate.wait(); });
+    MyContainer<int> c(std::vector<int>{3, 1, 2});
+    PermutationFuture pending = c.prepare_async(AscendingMapping(), pool);
+    // The queued build is taken over by the reader instead of waiting for the worker.
+    CHECK(*c.begin_ascending_order() == 1);
+    CHECK(pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    release.set_value();
+    blocker.get();
+}
+
+TEST_CASE("Streaming ascending order matches the sorted order") {
+    ThreadPool pool(2);
+    MyContainer<int> c;
+    CHECK(c.begin_streaming_ascending_order(pool) == c.end_streaming_ascending_order());
+    for (int i = 0; i < 50000; ++i) c.add((i * 7919) % 1000 - 500);
+    std::vector<int> expected = c.to_vector(AscendingMapping());
+
+    std::vector<int> streamed;
+    for (auto it = c.begin_streaming_ascending_order(pool); it != c.end_streaming_ascending_order(); ++it) {
+        streamed.push_back(*it);
+    }
+    CHECK(streamed == expected);
+
+    // The stream reads a snapshot, so the container may change underneath it.
+    auto it = c.begin_streaming_ascending_order(pool);
+    c.add(-1000);
+    CHECK(*it == -500);
+    CHECK(*c.begin_streaming_ascending_order(pool) == -1000);
+
+    // A traversal covers its snapshot and then meets the end, even if the size changes mid-loop.
+    size_t visited = 0;
+    for (auto grow = c.begin_streaming_ascending_order(pool); grow != c.end_streaming_ascending_order(); ++grow) {
+        if (visited++ % 1000 == 0) c.add(0);
+    }
+    CHECK(visited == 50001);
+    size_t before_removals = c.size();
+    visited = 0;
+    for (auto shrink = c.begin_streaming_ascending_order(pool); shrink != c.end_streaming_ascending_order(); ++shrink) {
+        if (visited++ == 0) c.remove(0);
+    }
+    CHECK(visited == before_removals);
+
+    MyContainer<std::string> words(std::vector<std::string>{"pear", "apple", "fig"});
+    auto w = words.begin_streaming_ascending_order(pool);
+    CHECK(*w++ == "apple");
+    CHECK(w->size() == 3);
+    ++w;
+    CHECK(*w == "pear");
+    ++w;
+    CHECK(w == words.end_streaming_ascending_order());
+    CHECK_THROWS_AS(*w, std::out_of_range);
+    CHECK_THROWS_AS(++w, std::out_of_range);
+}
+
+TEST_CASE("Streaming ascending order when no pool worker is free") {
+    ThreadPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::promise<void> started;
+    auto blocker = pool.submit([gate, &started]() { started.set_value(); gate.wait(); });
+    // Queued tasks run newest first, so make sure the blocker holds the worker already.
+    started.get_future().wait();
+    MyContainer<int> c;
+    for (int i = 100000; i > 0; --i) c.add(i);
+    auto it = c.begin_streaming_ascending_order(pool);
+    // The reader sorts what it needs itself; only a prefix of buckets is done.
+    CHECK(*it == 1);
+    CHECK(it.available() < c.size());
+    release.set_value();
+    blocker.get();
+    size_t n = 0;
+    int previous = 0;
+    bool sorted = true;
+    for (; it != c.end_streaming_ascending_order(); ++it, ++n) {
+        sorted = sorted && *it > previous;
+        previous = *it;
+    }
+    CHECK(sorted);
+    CHECK(n == c.size());
+}
+
+// Instrumentation adds counted scratch buffers and a statistics sink per cache.
+#ifndef MYCONTAINER_INSTRUMENT
+TEST_CASE("Allocation budgets for iterators") {
+    REQUIRE(allocation_tracking_enabled());
+    for (int n : {100, 100000}) {
+        MyContainer<int> c;
+        for (int i = 0; i < n; ++i) c.add((i * 7919) % n);
+
+        ScopedAllocationCounter scope;
+        auto a = c.end_ascending_order();
+        auto d = c.end_descending_order();
+        auto s = c.end_side_cross_order();
+        auto r = c.end_random_order(5);
+        CHECK(scope.allocations() == 0);
+
+        // Closed-form orders never allocate.
+        long long total = 0;
+        for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it) total += *it;
+        for (auto it = c.begin_random_order(5); it != r; ++it) total += *it;
+        for (auto it = c.begin_reverse_order(); it != c.end_reverse_order(); ++it) total += *it;
+        CHECK(scope.allocations() == 0);
+
+        // The first sorted traversal builds the permutation once: its index
+        // buffer and the small block that shares it with iterators, and nothing
+        // for the cache itself. Later traversals reuse it.
+        scope.reset();
+        for (auto it = c.begin_ascending_order(); it != a; ++it) total += *it;
+        size_t cold = scope.allocations();
+        size_t cold_bytes = scope.bytes();
+        CHECK(cold == 2);
+        CHECK(cold_bytes >= n * sizeof(size_t));
+        CHECK(cold_bytes < n * sizeof(size_t) + 128);
+        scope.reset();
+        for (auto it = c.begin_ascending_order(); it != a; ++it) total += *it;
+        for (auto it = c.begin_ascending_order(); it != a; ++it) total += *it;
+        CHECK(scope.allocations() == 0);
+
+        // Side-cross sorts into a scratch buffer of its own: one extra allocation.
+        scope.reset();
+        for (auto it = c.begin_side_cross_order(); it != s; ++it) total += *it;
+        CHECK(scope.allocations() <= cold + 1);
+        (void)d;
+        CHECK(total == 7LL * c.sum());
+    }
+}
+
+TEST_CASE("Allocation budgets for copies and reductions") {
+    MyContainer<int> c(std::vector<int>(1000, 7));
+    ScopedAllocationCounter scope;
+    MyContainer<int> copy = c;
+    CHECK(copy.sum() == 7000);
+    CHECK(c.minmax().first == 7);
+    CHECK(c.count(7) == 1000);
+    CHECK(c.contains(7));
+    CHECK(scope.allocations() == 0);
+    // The first write detaches: new buffer, its control block and a fresh cache.
+    copy.add(1);
+    CHECK(scope.allocations() <= 4);
+}
+#endif
+
+TEST_CASE("Instrumentation statistics for index builds") {
+    MyContainer<int> c;
+    const int n = 1000;
+    for (int i = 0; i < n; ++i) c.add((i * 7919) % n);
+    InstrumentationStats none = c.stats();
+    CHECK(none.index_builds == 0);
+    CHECK(none.comparisons == 0);
+
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {}
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {}
+    for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it) {}
+    InstrumentationStats ascending = c.stats();
+#ifdef MYCONTAINER_INSTRUMENT
+    CHECK(ascending.enabled);
+    // Built once (cached), with at least n - 1 and at most a few n log n comparisons.
+    CHECK(ascending.index_builds == 1);
+    CHECK(ascending.comparisons >= n - 1);
+    CHECK(ascending.comparisons <= 4 * n * 10);
+    CHECK(ascending.index_moves > 0);
+    CHECK(ascending.index_bytes == n * sizeof(size_t));
+
+    // Side-cross sorts into a scratch buffer, then scatters into its own.
+    for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) {}
+    InstrumentationStats side_cross = c.stats();
+    CHECK(side_cross.index_builds == 2);
+    CHECK(side_cross.comparisons - ascending.comparisons == ascending.comparisons);
+    CHECK(side_cross.index_bytes - ascending.index_bytes == 2 * n * sizeof(size_t));
+    CHECK(side_cross.build_ns >= ascending.build_ns);
+
+    // Totals survive copy-on-write and are cleared by reset_stats().
+    MyContainer<int> copy = c;
+    copy.add(5);
+    CHECK(copy.stats().index_builds == 2);
+    copy.reset_stats();
+    CHECK(copy.stats().index_builds == 0);
+    CHECK(c.stats().index_builds == 2);
+#else
+    CHECK_FALSE(ascending.enabled);
+    CHECK(ascending.index_builds == 0);
+    CHECK(ascending.comparisons == 0);
+    CHECK(ascending.build_ns == 0);
+#endif
+}
+
+TEST_CASE("memory_usage accounts for elements, indexes and iterators") {
+    MyContainer<int> c;
+    for (int i = 0; i < 1000; ++i) c.add(1000 - i);
+    MemoryUsage empty_index = c.memory_usage();
+    CHECK(empty_index.element_bytes == 1000 * sizeof(int));
+    CHECK(empty_index.capacity_slack_bytes == (static_cast<const MyContainer<int>&>(c).getData().capacity() - 1000) * sizeof(int));
+    CHECK(empty_index.element_heap_bytes == 0);
+    CHECK(empty_index.live_index_bytes == 0);
+    CHECK(empty_index.filter_bytes == 0);
+
+    const size_t index = 1000 * sizeof(size_t);
+    {
+        auto it = c.begin_ascending_order();
+        MemoryUsage sorted = c.memory_usage();
+        CHECK(sorted.cached_permutation_bytes == index);
+        CHECK(sorted.live_index_bytes == index);
+
+        // A mutation drops the cached permutation, but the iterator still holds it.
+        c.add(0);
+        auto it2 = c.begin_descending_order();
+        MemoryUsage held = c.memory_usage();
+        CHECK(held.cached_permutation_bytes == 1001 * sizeof(size_t));
+        CHECK(held.live_index_bytes == index + 1001 * sizeof(size_t));
+        CHECK(held.peak_index_bytes == held.live_index_bytes);
+        CHECK(held.total() == held.element_bytes + held.capacity_slack_bytes + held.live_index_bytes);
+        CHECK(*it == 1);
+        CHECK(*it2 == 1000);
+    }
+    c.add(5);
+    MemoryUsage released = c.memory_usage();
+    CHECK(released.live_index_bytes == 0);
+    CHECK(released.peak_index_bytes == index + 1001 * sizeof(size_t));
+    c.reset_peak_memory();
+    CHECK(c.memory_usage().peak_index_bytes == 0);
+
+    c.enable_membership_filter();
+    CHECK(c.memory_usage().filter_bytes == c.filter_stats().memory_bytes);
+
+    MyContainer<std::string> strings;
+    strings.add("short");
+    strings.add(std::string(100, 'x'));
+    MemoryUsage text = strings.memory_usage();
+    CHECK(text.element_bytes == 2 * sizeof(std::string));
+    CHECK(text.element_heap_bytes >= 101);
+}
+
+TEST_CASE("Tracing records spans as Chrome trace events") {
+    clear_trace();
+    MyContainer<int> c;
+    for (int i = 0; i < 100; ++i) c.add(100 - i);
+    auto it = c.begin_ascending_order();
+    c.remove(50);
+    MyContainer<int> copy = c;
+    copy.add(1);
+    std::thread worker([&]() { MyContainer<int> other(std::vector<int>{3, 1, 2}); other.begin_side_cross_order(); });
+    worker.join();
+
+    std::ostringstream out;
+    write_chrome_trace(out);
+    std::string trace = out.str();
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+#ifdef MYCONTAINER_TRACE
+    CHECK(tracing_enabled());
+    CHECK(trace.find("\"name\": \"AscendingOrder index build\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"vector realloc\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"remove compaction\"") != std::string::npos);
+    CHECK(trace.find("\"name\": \"copy-on-write detach\"") != std::string::npos);
+    CHECK(trace.find("\"ph\": \"X\"") != std::string::npos);
+    // The worker's build lands on a track of its own.
+    size_t side_cross = trace.find("SideCrossOrder index build");
+    size_t ascending = trace.find("AscendingOrder index build");
+    REQUIRE(side_cross != std::string::npos);
+    auto tid_after = [&](size_t at) { size_t p = trace.find("\"tid\": ", at); return trace.substr(p, trace.find(',', p) - p); };
+    CHECK(tid_after(side_cross) != tid_after(ascending));
+    CHECK(dropped_trace_events() == 0);
+    clear_trace();
+    std::ostringstream cleared;
+    write_chrome_trace(cleared);
+    CHECK(cleared.str().find("\"ph\"") == std::string::npos);
+#else
+    CHECK_FALSE(tracing_enabled());
+    CHECK(trace.find("\"ph\"") == std::string::npos);
+#endif
+    CHECK(*it == 1);
+}
+
+template<typename T>
+static std::string print_each(const std::vector<T>& values, const std::ostream& format) {
+    std::ostringstream os;
+    os.copyfmt(format);
+    os << "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        os << values[i];
+        if (i + 1 < values.size()) os << ", ";
+    }
+    os << "]";
+    return os.str();
+}
+
+template<typename T>
+static void check_printing(const std::vector<T>& values, const std::ostream& format) {
+    std::ostringstream os;
+    os.copyfmt(format);
+    os << MyContainer<T>(values);
+    CHECK(os.str() == print_each(values, format));
+}
+
+TEST_CASE("operator<< output matches element-wise insertion") {
+    std::ostringstream plain;
+    MyContainer<int> c;
+    std::ostringstream empty;
+    empty << c;
+    CHECK(empty.str() == "[]");
+    c.add(-7);
+    c.add(0);
+    c.add(42);
+    plain << c;
+    CHECK(plain.str() == "[-7, 0, 42]");
+
+    std::vector<int> ints;
+    std::vector<long long> longs;
+    std::vector<double> doubles = {0.0, -0.0, 0.1, 1e-5, 123456.0, 1234567.0, 1e300, 5e-324,
+                                   std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN()};
+    std::vector<float> floats = {1.5f, -0.25f, 3.14159f, 1e30f};
+    for (int i = 0; i < 100000; ++i) {
+        ints.push_back(static_cast<int>(detail::mix64(i)));
+        longs.push_back(static_cast<long long>(detail::mix64(i)));
+        doubles.push_back(static_cast<double>(detail::mix64(i) >> 11) * 1e-9 - 4.5e6);
+    }
+    std::ostringstream format;
+    check_printing(ints, format);
+    check_printing(longs, format);
+    check_printing(doubles, format);
+    check_printing(floats, format);
+    for (int precision : {0, 1, 3, 17, 30}) {
+        format.precision(precision);
+        check_printing(doubles, format);
+    }
+
+    // Non-default formatting and non-numeric types go through operator<< per element.
+    std::ostringstream hex;
+    hex << std::hex << std::showbase;
+    check_printing(ints, hex);
+    std::ostringstream fixed;
+    fixed << std::fixed;
+    check_printing(doubles, fixed);
+    std::ostringstream wide;
+    wide.width(8);
+    check_printing(ints, wide);
+    check_printing(std::vector<char>{'a', 'b'}, format);
+    check_printing(std::vector<std::string>{"x", "yz"}, format);
+}
+
+TEST_CASE("from_text and from_file parse columns with from_chars") {
+    CHECK(MyContainer<int>::from_text("1\n-2\n+3\n\n40\n").getData() == std::vector<int>{1, -2, 3, 40});
+
+    LoadOptions csv;
+    csv.column = 1;
+    csv.header = true;
+    MyContainer<double> prices = MyContainer<double>::from_text("id,price\r\n1, 2.5\r\n2,1e3\r\n3,-0.125", csv);
+    CHECK(prices.getData() == std::vector<double>{2.5, 1000.0, -0.125});
+
+    CHECK(MyContainer<long long>::from_text("1 2\t3\n 4   5\n", LoadOptions::whitespace()).size() == 5);
+    CHECK(MyContainer<std::string>::from_text("a,b\nc,d\n", csv).getData() == std::vector<std::string>{"d"});
+    CHECK(MyContainer<int>::from_text("").size() == 0);
+
+    CHECK_THROWS_AS(MyContainer<int>::from_text("1\n2x\n3\n"), std::invalid_argument);
+    CHECK_THROWS_AS(MyContainer<int>::from_text("1\n99999999999\n"), std::invalid_argument);
+    CHECK_THROWS_WITH(MyContainer<double>::from_text("id,price\n1,2\n2\n", csv), "Invalid or missing value at line 3");
+    CHECK_THROWS_AS(MyContainer<int>::from_file("no/such/file.csv"), std::invalid_argument);
+
+    // Large enough for several chunks: boundaries must neither drop nor duplicate lines.
+    std::string text = "value,other\n";
+    std::vector<int> expected;
+    for (int i = 0; i < 200000; ++i) {
+        int value = static_cast<int>(detail::mix64(static_cast<uint64_t>(i)));
+        expected.push_back(value);
+        text += std::to_string(value) + "," + std::to_string(i) + "\n";
+    }
+    ThreadPool pool(3);
+    LoadOptions parallel;
+    parallel.header = true;
+    parallel.pool = &pool;
+    CHECK(MyContainer<int>::from_text(text, parallel).getData() == expected);
+    text += "oops,1\n";
+    CHECK_THROWS_WITH(MyContainer<int>::from_text(text, parallel), "Invalid or missing value at line 200002");
+    text.resize(text.size() - 7);
+
+    const char* path = "from_file_test.csv";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+    MyContainer<int> loaded = MyContainer<int>::from_file(path, parallel);
+    std::remove(path);
+    CHECK(loaded.getData() == expected);
+
+    // An empty file is not mapped, so there is no buffer to look for the header in.
+    std::ofstream(path, std::ios::binary).close();
+    MyContainer<int> empty = MyContainer<int>::from_file(path, parallel);
+    std::remove(path);
+    CHECK(empty.size() == 0);
+    CHECK(MyContainer<int>::from_text(std::string_view(), parallel).size() == 0);
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MyContainerNamespace {
+
+    /**
+     * @brief Small work-stealing thread pool.
+     *
+     * Every worker owns a task deque: it takes its own newest task first and,
+     * when idle, steals the oldest task of another worker. Tasks submitted
+     * from a worker go to that worker's deque; tasks from outside are spread
+     * round-robin. run_chunks() is a fork/join loop in which the calling
+     * thread works alongside the pool, so it may be nested inside pool tasks.
+     */
+    class ThreadPool {
+    private:
+        struct TaskQueue {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleep_lock;
+        std::condition_variable wake;
+        std::atomic<size_t> pending{0};
+        std::atomic<size_t> next_queue{0};
+        bool stopping = false;
+
+        inline static thread_local ThreadPool* current_pool = nullptr;
+        inline static thread_local size_t current_worker = 0;
+
+        void enqueue(std::function<void()> task) {
+            size_t index = (current_pool == this) ? current_worker
+                                                  : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard<std::mutex> guard(queues[index]->lock);
+                queues[index]->tasks.push_back(std::move(task));
+            }
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            pending.fetch_add(1, std::memory_order_relaxed);
+            wake.notify_one();
+        }
+
+        /**
+         * @brief Runs one task: the newest of queue `home`, else the oldest of any other queue.
+         * @return False if every queue was empty.
+         */
+        bool run_one(size_t home) {
+            std::function<void()> task;
+            for (size_t i = 0; i < queues.size() && !task; ++i) {
+                TaskQueue& queue = *queues[(home + i) % queues.size()];
+                std::lock_guard<std::mutex> guard(queue.lock);
+                if (queue.tasks.empty()) {
+                    continue;
+                }
+                if (i == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+            }
+            if (!task) {
+                return false;
+            }
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+
+        void worker_loop(size_t index) {
+            current_pool = this;
+            current_worker = index;
+            for (;;) {
+                if (run_one(index)) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> guard(sleep_lock);
+                wake.wait(guard, [this]() { return stopping || pending.load(std::memory_order_relaxed) > 0; });
+                if (stopping && pending.load(std::memory_order_relaxed) == 0) {
+                    return;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor for the pool.
+         * @param worker_count Number of worker threads (at least one is started).
+         */
+        explicit ThreadPool(size_t worker_count) {
+            worker_count = std::max<size_t>(worker_count, 1);
+            for (size_t i = 0; i < worker_count; ++i) {
+                queues.push_back(std::make_unique<TaskQueue>());
+            }
+            for (size_t i = 0; i < worker_count; ++i) {
+                workers.emplace_back([this, i]() { worker_loop(i); });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Destructor. Finishes every queued task, then joins the workers.
+         */
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @brief Returns the number of worker threads.
+         * @return The worker count.
+         */
+        size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Runs f asynchronously on the pool.
+         * @param f Callable taking no arguments.
+         * @return Future for f's result; it rethrows anything f throws.
+         */
+        template<typename F>
+        std::future<std::invoke_result_t<F>> submit(F f) {
+            using R = std::invoke_result_t<F>;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::move(f));
+            std::future<R> result = task->get_future();
+            enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        /**
+         * @brief Calls f(c) for every chunk c in [0, chunks) and waits for all of them.
+         *
+         * Chunks are claimed dynamically by the calling thread and by up to
+         * size() workers. The first exception thrown by any chunk is rethrown
+         * once every claimed chunk has finished; unclaimed chunks are skipped.
+         * @param chunks Number of chunks.
+         * @param f Callable taking the chunk number (size_t).
+         */
+        template<typename F>
+        void run_chunks(size_t chunks, F&& f) {
+            if (chunks == 0) {
+                return;
+            }
+            struct Group {
+                std::atomic<size_t> next{0};
+                std::atomic<size_t> finished{0};
+                std::atomic<bool> failed{false};
+                std::exception_ptr error;
+                std::mutex lock;
+                std::condition_variable done;
+            };
+            auto group = std::make_shared<Group>();
+            auto* body = &f;
+            auto work = [group, body, chunks]() {
+                for (size_t c; (c = group->next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+                    if (!group->failed.load(std::memory_order_relaxed)) {
+                        try {
+                            (*body)(c);
+                        } catch (...) {
+                            std::lock_guard<std::mutex> guard(group->lock);
+                            if (!group->error) {
+                                group->error = std::current_exception();
+                            }
+                            group->failed.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                    if (group->finished.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                        std::lock_guard<std::mutex> guard(group->lock);
+                        group->done.notify_all();
+                    }
+                }
+            };
+            size_t helpers = std::min(chunks - 1, workers.size());
+            for (size_t i = 0; i < helpers; ++i) {
+                enqueue(work);
+            }
+            work();
+            std::unique_lock<std::mutex> guard(group->lock);
+            group->done.wait(guard, [&]() { return group->finished.load(std::memory_order_acquire) == chunks; });
+            if (group->error) {
+                std::rethrow_exception(group->error);
+            }
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Process-wide pool used by the parallel algorithms, sized to the hardware.
+         */
+        inline ThreadPool& default_pool() {
+            static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+            return pool;
+        }
+    }
+
+}
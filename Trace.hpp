@@ -0,0 +1,218 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#ifdef MYCONTAINER_TRACE
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+/**
+ * @brief Events each thread can record before further ones are dropped.
+ */
+#ifndef MYCONTAINER_TRACE_EVENTS
+#define MYCONTAINER_TRACE_EVENTS 65536
+#endif
+
+#define MYCONTAINER_TRACE_CONCAT_(a, b) a##b
+#define MYCONTAINER_TRACE_CONCAT(a, b) MYCONTAINER_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief MYCONTAINER_TRACE_SPAN(name, size) records the rest of the enclosing
+ * scope as a span; MYCONTAINER_TRACE_SPAN_IF(condition, name, size) only if
+ * condition holds. name must point to a string with static storage duration.
+ * Without MYCONTAINER_TRACE both expand to nothing and their arguments are
+ * not evaluated.
+ */
+#ifdef MYCONTAINER_TRACE
+#define MYCONTAINER_TRACE_SPAN(name, size) \
+    ::MyContainerNamespace::detail::TraceSpan MYCONTAINER_TRACE_CONCAT(trace_span_, __LINE__)((name), (size))
+#define MYCONTAINER_TRACE_SPAN_IF(condition, name, size) \
+    ::MyContainerNamespace::detail::TraceSpan MYCONTAINER_TRACE_CONCAT(trace_span_, __LINE__)( \
+        (condition) ? (name) : nullptr, (size))
+#else
+#define MYCONTAINER_TRACE_SPAN(name, size) static_cast<void>(0)
+#define MYCONTAINER_TRACE_SPAN_IF(condition, name, size) static_cast<void>(0)
+#endif
+
+namespace MyContainerNamespace {
+
+#ifdef MYCONTAINER_TRACE
+    namespace detail {
+        /**
+         * @brief One completed span.
+         */
+        struct TraceEvent {
+            const char* name;
+            uint64_t start_ns;
+            uint64_t duration_ns;
+            uint64_t size;
+        };
+
+        /**
+         * @brief Fixed-size event log written only by its owning thread.
+         *
+         * The owner fills the next slot and then publishes it with a release
+         * store of count, so readers see complete events without locking.
+         */
+        struct TraceBuffer {
+            explicit TraceBuffer(size_t thread_id) : tid(thread_id), events(MYCONTAINER_TRACE_EVENTS) {}
+
+            const size_t tid;
+            std::vector<TraceEvent> events;
+            std::atomic<size_t> count{0};
+            std::atomic<size_t> dropped{0};
+
+            void record(const TraceEvent& event) {
+                size_t n = count.load(std::memory_order_relaxed);
+                if (n == events.size()) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                events[n] = event;
+                count.store(n + 1, std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief Every thread's buffer, kept after the thread exits so its events can still be written.
+         */
+        struct TraceRegistry {
+            std::mutex lock;
+            std::vector<std::shared_ptr<TraceBuffer>> buffers;
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        };
+
+        inline TraceRegistry& trace_registry() {
+            static TraceRegistry registry;
+            return registry;
+        }
+
+        /**
+         * @brief The calling thread's buffer, registered on first use.
+         */
+        inline TraceBuffer& thread_trace_buffer() {
+            thread_local std::shared_ptr<TraceBuffer> buffer = []() {
+                TraceRegistry& registry = trace_registry();
+                std::lock_guard<std::mutex> guard(registry.lock);
+                registry.buffers.push_back(std::make_shared<TraceBuffer>(registry.buffers.size() + 1));
+                return registry.buffers.back();
+            }();
+            return *buffer;
+        }
+
+        inline uint64_t trace_now_ns() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - trace_registry().epoch).count());
+        }
+
+        /**
+         * @brief Records its own lifetime as a span on the calling thread (nothing if name is null).
+         */
+        class TraceSpan {
+        private:
+            const char* name;
+            uint64_t size;
+            uint64_t start;
+
+        public:
+            TraceSpan(const char* span_name, size_t span_size)
+                : name(span_name), size(span_size), start(span_name ? trace_now_ns() : 0) {}
+
+            TraceSpan(const TraceSpan&) = delete;
+            TraceSpan& operator=(const TraceSpan&) = delete;
+
+            ~TraceSpan() {
+                if (name) {
+                    thread_trace_buffer().record({name, start, trace_now_ns() - start, size});
+                }
+            }
+        };
+    }
+#endif
+
+    /**
+     * @brief Whether container operations are being traced (MYCONTAINER_TRACE defined).
+     * @return True if spans are recorded.
+     */
+    inline bool tracing_enabled() {
+#ifdef MYCONTAINER_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Writes every recorded span in Chrome trace-event JSON, viewable in
+     * Perfetto or chrome://tracing.
+     *
+     * Spans are complete ("ph": "X") events with microsecond timestamps, one
+     * track per thread, and the span's element count in args.size. May run
+     * while other threads keep recording; their newer spans are just missed.
+     * Without MYCONTAINER_TRACE the event list is empty.
+     * @param os The stream to write to.
+     */
+    inline void write_chrome_trace(std::ostream& os) {
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+#ifdef MYCONTAINER_TRACE
+        std::vector<std::shared_ptr<detail::TraceBuffer>> buffers;
+        {
+            detail::TraceRegistry& registry = detail::trace_registry();
+            std::lock_guard<std::mutex> guard(registry.lock);
+            buffers = registry.buffers;
+        }
+        bool first = true;
+        char number[64];
+        for (const auto& buffer : buffers) {
+            size_t n = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i) {
+                const detail::TraceEvent& event = buffer->events[i];
+                os << (first ? "\n" : ",\n") << "{\"name\": \"" << event.name
+                   << "\", \"cat\": \"MyContainer\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid;
+                std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.start_ns) / 1000.0);
+                os << ", \"ts\": " << number;
+                std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.duration_ns) / 1000.0);
+                os << ", \"dur\": " << number << ", \"args\": {\"size\": " << event.size << "}}";
+                first = false;
+            }
+        }
+#endif
+        os << "\n]}\n";
+    }
+
+    /**
+     * @brief Number of spans dropped because a thread's buffer was full.
+     * @return The total over all threads.
+     */
+    inline size_t dropped_trace_events() {
+        size_t dropped = 0;
+#ifdef MYCONTAINER_TRACE
+        detail::TraceRegistry& registry = detail::trace_registry();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        for (const auto& buffer : registry.buffers) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+#endif
+        return dropped;
+    }
+
+    /**
+     * @brief Discards every recorded span. Call only while no thread is recording.
+     */
+    inline void clear_trace() {
+#ifdef MYCONTAINER_TRACE
+        detail::TraceRegistry& registry = detail::trace_registry();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        for (const auto& buffer : registry.buffers) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+#endif
+    }
+
+}